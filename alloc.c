@@ -0,0 +1,215 @@
+/*****************************************************************************
+	alloc.c	- Accounting allocator
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Every block is charged to the pool of the subsystem that asked for
+	it. A small header in front of the block remembers its size and pool
+	so it can be handed back when the block is freed, whichever thread
+	frees it.
+
+	The memory is charged to the stats the thread is attached to, which
+	gives the memory of each module, and to totals for the whole process
+	that show how much the modules in flight at the same time need.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "stats.h"
+#include "platform.h"
+
+typedef union
+{
+	struct
+	{
+		u_int32		size;	/* Bytes asked for */
+		MEMPOOL		pool;	/* Pool the bytes are charged to */
+	} info;
+	double			align;	/* Keeps the block aligned for any type */
+	void			*alignPointer;
+} AllocHeader;
+
+static volatile long totalAllocs[MEM_COUNT + 1];
+static volatile long totalBytes[MEM_COUNT + 1];
+static volatile long totalLive[MEM_COUNT + 1];
+static volatile long totalPeak[MEM_COUNT + 1];
+
+
+
+/*************************************************************************** 
+	Charge a change in the size of a block to the stats of a pool
+***************************************************************************/
+static void ChargeStats(MemoryStats *stats, long change, BOOL allocated)
+{
+	if(TRUE == allocated)
+	{
+		stats->allocs++;
+	}
+	if(change > 0)
+	{
+		stats->bytes += change;
+	}
+
+	stats->live += change;
+	if(stats->live > stats->peak)
+	{
+		stats->peak = stats->live;
+	}
+}
+
+
+static void ChargeTotals(int index, long change, BOOL allocated)
+{
+	if(TRUE == allocated)
+	{
+		AtomicAdd(&totalAllocs[index], 1);
+	}
+	if(change > 0)
+	{
+		AtomicAdd(&totalBytes[index], change);
+	}
+
+	AtomicMax(&totalPeak[index], AtomicAdd(&totalLive[index], change));
+}
+
+
+static void Charge(MEMPOOL pool, long change, BOOL allocated)
+{
+	ChargeTotals(pool, change, allocated);
+	ChargeTotals(MEM_TOTAL, change, allocated);
+
+	if(NULL != statsTarget)
+	{
+		ChargeStats(&statsTarget->memory[pool], change, allocated);
+		ChargeStats(&statsTarget->memory[MEM_TOTAL], change, allocated);
+
+		if(TRUE == allocated)
+		{
+			statsTarget->counts[STAT_ALLOCS]++;
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Allocate zeroed memory charged to pool
+***************************************************************************/
+void *MemAlloc(MEMPOOL pool, u_int32 size)
+{
+	AllocHeader *header;
+
+	header = calloc(1, sizeof(AllocHeader) + size);
+	if(NULL == header)
+	{
+		return NULL;
+	}
+
+	header->info.size = size;
+	header->info.pool = pool;
+	Charge(pool, (long)size, TRUE);
+
+	return header + 1;
+}
+
+
+/*************************************************************************** 
+	Resize a block from MemAlloc, or allocate one from pool if mem is
+	NULL. A block stays in the pool it was first allocated from and the
+	bytes added are not zeroed. On failure the block is left as it was
+	and NULL is returned.
+***************************************************************************/
+void *MemRealloc(MEMPOOL pool, void *mem, u_int32 size)
+{
+	AllocHeader *header;
+	u_int32 oldSize;
+
+	if(NULL == mem)
+	{
+		return MemAlloc(pool, size);
+	}
+
+	header = (AllocHeader *)mem - 1;
+	oldSize = header->info.size;
+	pool = header->info.pool;
+
+	header = realloc(header, sizeof(AllocHeader) + size);
+	if(NULL == header)
+	{
+		return NULL;
+	}
+
+	header->info.size = size;
+	Charge(pool, (long)size - (long)oldSize, TRUE);
+
+	return header + 1;
+}
+
+
+/*************************************************************************** 
+	Free a block from MemAlloc or MemRealloc
+***************************************************************************/
+void MemFree(void *mem)
+{
+	AllocHeader *header;
+
+	if(NULL == mem)
+	{
+		return;
+	}
+
+	header = (AllocHeader *)mem - 1;
+	Charge(header->info.pool, -(long)header->info.size, FALSE);
+	free(header);
+}
+
+
+/*************************************************************************** 
+	Get the memory of the whole process, one entry for each pool and
+	MEM_TOTAL for all of them
+***************************************************************************/
+void MemGetTotals(MemoryStats *totals)
+{
+	int index;
+
+	for(index = 0; index <= MEM_TOTAL; index++)
+	{
+		totals[index].allocs = (u_int32)AtomicLoad(&totalAllocs[index]);
+		totals[index].bytes = (u_int32)AtomicLoad(&totalBytes[index]);
+		totals[index].live = AtomicLoad(&totalLive[index]);
+		totals[index].peak = AtomicLoad(&totalPeak[index]);
+	}
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,178 @@
+/*****************************************************************************
+	datascan.c	- Classification of data bytes for fcc/fcb segmentation
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Data is classified into bit masks, one bit per byte, so the renderer
+	can find where the next fcc or fcb line has to start by looking for
+	the next set bit instead of testing every byte. SSE2 is used when the
+	compiler targets it, 16 bytes at a time.
+
+*****************************************************************************/
+#include <string.h>
+#include "datascan.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+
+/*************************************************************************** 
+	Set a bit in textMask for every byte that can be part of an fcc
+	string and in asciiMask for every byte from $20 to $7f. Bits past
+	count are cleared.
+***************************************************************************/
+void ScanText(const u_char *bytes, u_int32 count, u_int32 *textMask, u_int32 *asciiMask)
+{
+	u_int32 index;
+
+	memset(textMask, 0, SCAN_WORDS(count) * sizeof(u_int32));
+	memset(asciiMask, 0, SCAN_WORDS(count) * sizeof(u_int32));
+
+	index = 0;
+
+#ifdef SCAN_SSE2
+	{
+		/* The compare is signed so bytes from $80 up are below $20 */
+		const __m128i low = _mm_set1_epi8(0x1f);
+		const __m128i quote = _mm_set1_epi8('"');
+
+		for(; index + 16 <= count; index += 16)
+		{
+			__m128i value;
+			__m128i ascii;
+			u_int32 bits;
+			u_int32 text;
+
+			value = _mm_loadu_si128((const __m128i *)(bytes + index));
+			ascii = _mm_cmpgt_epi8(value, low);
+			bits = (u_int32)_mm_movemask_epi8(ascii);
+			text = bits & ~(u_int32)_mm_movemask_epi8(_mm_cmpeq_epi8(value, quote));
+
+			asciiMask[index / 32] |= bits << (index % 32);
+			textMask[index / 32] |= text << (index % 32);
+		}
+	}
+#endif
+
+	for(; index < count; index++)
+	{
+		if(bytes[index] >= 0x20 && bytes[index] <= 0x7f)
+		{
+			asciiMask[index / 32] |= 1UL << (index % 32);
+			if('"' != bytes[index])
+			{
+				textMask[index / 32] |= 1UL << (index % 32);
+			}
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Set a bit in mask for every flag byte that is not zero. Bits already
+	set are kept so several flag tables can be merged.
+***************************************************************************/
+void ScanFlags(const u_char *flags, u_int32 count, u_int32 *mask)
+{
+	u_int32 index;
+
+	index = 0;
+
+#ifdef SCAN_SSE2
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		for(; index + 16 <= count; index += 16)
+		{
+			__m128i value;
+			u_int32 bits;
+
+			value = _mm_loadu_si128((const __m128i *)(flags + index));
+			bits = ~(u_int32)_mm_movemask_epi8(_mm_cmpeq_epi8(value, zero)) & 0xffff;
+			mask[index / 32] |= bits << (index % 32);
+		}
+	}
+#endif
+
+	for(; index < count; index++)
+	{
+		if(0 != flags[index])
+		{
+			mask[index / 32] |= 1UL << (index % 32);
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Find the first set bit at or after from. Returns count if there is
+	none.
+***************************************************************************/
+u_int32 ScanNext(const u_int32 *mask, u_int32 from, u_int32 count)
+{
+	u_int32 word;
+	u_int32 bits;
+
+	if(from >= count)
+	{
+		return count;
+	}
+
+	word = from / 32;
+	bits = mask[word] & (0xffffffffUL << (from % 32));
+
+	while(0 == bits)
+	{
+		if(++word >= SCAN_WORDS(count))
+		{
+			return count;
+		}
+		bits = mask[word];
+	}
+
+	/* Lowest set bit */
+	from = word * 32;
+	while(0 == (bits & 1))
+	{
+		bits >>= 1;
+		from++;
+	}
+
+	return from < count ? from : count;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,50 @@
+/*****************************************************************************
+	datascan.h	- Classification of data bytes for fcc/fcb segmentation
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#ifndef DATASCAN_H
+#define DATASCAN_H
+
+#include "util.h"
+
+#define SCAN_WORDS(count)	(((count) + 31) / 32)	/* Mask words needed for count bytes */
+
+void ScanText(const u_char *bytes, u_int32 count, u_int32 *textMask, u_int32 *asciiMask);
+void ScanFlags(const u_char *flags, u_int32 count, u_int32 *mask);
+u_int32 ScanNext(const u_int32 *mask, u_int32 from, u_int32 count);
+
+#endif	/* DATASCAN_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
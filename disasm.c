@@ -17,8 +17,6 @@
 
 		Add 6309 support
 		Add support for RS-DOS .bin files
-		Generate a text in a buffer instead of to a file for interactive mode
-		Allow use of a memory description file
 		Add $FFxx port definitions and support
 		Change memory map to use bit table for possible use ON a CoCo
 		Change disassembly process to read from file for possible use ON a CoCo
@@ -32,6 +30,10 @@
 #include "disasm.h"
 #include "rof.h"
 #include "genasm.h"
+#include "hexfmt.h"
+#include "datascan.h"
+#include "platform.h"
+#include "stats.h"
 
 #define TRACE_RESET(x)				/* No longer used */
 #define SET_TRACEINFO(offset, val)	traceInfo[offset] = val
@@ -47,6 +49,13 @@
 #define TRACE_DATA		0x00
 #define TRACE_CODE		0x01
 
+#define MAX_TRACEDEPTH	4096	/* Maximum nesting of branches being traced */
+#define MAX_RENDER_THREADS	16		/* Most threads rendering one module */
+#define PARALLEL_RENDER_SIZE	8192	/* Smallest module rendered on several threads */
+
+#define LINE_RUNSTART	0x01	/* Line is the first in a run of data */
+#define LINE_TEXTMODE	0x02	/* Line follows a line of text data */
+
 
 typedef enum
 {
@@ -72,8 +81,14 @@ typedef enum
 static TSTATE	traceState = 0;		/* Current tracing state */
 static u_int16	maxPC = 0;			/* Maximum code byte offset */
 static int		disasmPass = 0;		/* Current disassembler pass */
-static u_int16	xxPC = 0;			/* Current PC */
+static THREAD_LOCAL u_int16	xxPC = 0;	/* Current PC */
 static OS9ROF	*rofFile = NULL;	/* Current ROF file */
+static int		traceDepth = 0;		/* Current nesting of traced branches */
+static int		traceResult = 0;	/* Set when the trace has to be abandoned */
+static THREAD_LOCAL int	disasmResult = 0;	/* Set when disassembly has to be abandoned */
+static BOOL		recording = FALSE;	/* Set when lines are captured for structured output */
+static RecordSink	*recordSink = NULL;	/* Receives the captured lines */
+static AsmRecord	asmRecord;			/* Line being captured */
 
 /*
 	The following tables could be better implemented as bit tables
@@ -84,10 +99,113 @@ static OS9ROF	*rofFile = NULL;	/* Current ROF file */
 	most .r files were no more than 1k in size so the extra work might
 	not be worth it - just reduce the value of MAX_MEMORY.
 */
-static u_char traceInfo[MAX_MEMORY];
+static u_char traceInfo[MAX_MEMORY + MAXOPSIZE];
 static u_char codeInfo[MAX_MEMORY];
 static u_char dataInfo[MAX_MEMORY];
 static u_char bssInfo[MAX_MEMORY];
+static u_char dataRefInfo[MAX_MEMORY];		/* Set where initialized data holds a local reference */
+
+/*
+	What the hints say about each byte of the code of the current module.
+	The ranges of its hint set are painted here so the tracer and the
+	data dumps look a byte up directly.
+*/
+static const Hints		*disasmHints = NULL;	/* Hints given with SetDisasmHints */
+static const HintSet	*hintSet = NULL;		/* Hints for the current module, NULL if none */
+static u_char			hintInfo[MAX_MEMORY];	/* HINTKIND of each byte of the code */
+static BOOL				hintsPainted = FALSE;	/* Set while hintInfo holds any ranges */
+
+#define IS_DATA_HINT(kind)	(HINT_NONE != (kind) && HINT_CODE != (kind))
+
+/*
+	The instruction that starts at each offset of the code as the tracer
+	sees it, and the flow class and length of every opcode it is built
+	from.
+*/
+typedef struct
+{
+	u_char		length;		/* Bytes to the next instruction */
+	u_char		marked;		/* Bytes the trace marks as code */
+	u_char		flow;		/* FLOW_NEXT, FLOW_BRANCH, FLOW_JUMP, or FLOW_RETURN */
+	u_int16		target;		/* Target of a branch or jump */
+} TraceStep;
+
+static TraceStep	traceSteps[MAX_MEMORY];
+static u_char		opFlow[3][256];		/* Flow class of the page 0, $10, and $11 opcodes */
+static u_char		opBytes[3][256];	/* Length of the opcodes without indexing */
+static BOOL			opFlowReady = FALSE;
+
+/*
+	Where a line of data has to be checked byte by byte again, one bit per
+	byte of the run being dumped. Bytes in between are added to the line
+	without looking at them.
+*/
+static THREAD_LOCAL u_int32	textBreaks[SCAN_WORDS(MAX_MEMORY) + 1];		/* Bytes that end an fcc line */
+static THREAD_LOCAL u_int32	binaryBreaks[SCAN_WORDS(MAX_MEMORY) + 1];	/* Bytes that end an fcb line */
+static THREAD_LOCAL u_int32	asciiMask[SCAN_WORDS(MAX_MEMORY) + 1];
+
+/*
+	Index of the lines in the code built by DisasmPrepare so a range of
+	addresses can be rendered without generating the lines before it.
+	Each entry keeps the data mode in effect before the line so data runs
+	can be resumed part way through.
+*/
+static BOOL		indexLines = FALSE;			/* Set while the index is built */
+static int		renderThreads = 1;			/* Threads rendering large modules */
+static BOOL		parallelRender = FALSE;		/* Set when the listing is rendered in chunks */
+
+typedef struct
+{
+	u_int16		start;		/* First address of the chunk */
+	u_int16		end;		/* Address after the chunk */
+	TextBuf		output;		/* Rendered lines of the chunk */
+	int			result;		/* Result of rendering the chunk */
+	char		error[256];	/* Why the chunk failed */
+	PhaseStats	stats;		/* Stats of a chunk rendered on its own thread */
+} RenderChunkInfo;
+static u_int32	lineCount = 0;				/* Number of lines in the index */
+static u_int16	lineStart[MAX_MEMORY];		/* Address of the start of each line */
+static u_char	lineFlags[MAX_MEMORY];		/* LINE_xxx flags for each line */
+
+/*
+	What DisasmUpdateHints needs to redo only the parts of a prepared
+	module that change with the hints. The first pass of DisasmPrepare
+	counts the operands referring to each code label so labels can be
+	dropped again, and DisasmRenderListing keeps where the lines are in
+	its listing.
+*/
+#define MAX_UPDATE_SPANS	256		/* Changed spans kept apart before merging them all */
+
+typedef struct
+{
+	u_int16		start;		/* First changed address, or first address of a region */
+	u_int32		end;		/* Last changed address, or address after a region */
+} UpdateSpan;
+
+static int			labelDelta = 0;					/* Added to labelRefs by the first pass, 0 for none */
+static u_int16		labelRefs[MAX_MEMORY];			/* Operands referring to each code label */
+static u_char		labelBase[MAX_MEMORY];			/* Code labels set by the references of the module */
+static u_int16		refTarget[MAX_MEMORY];			/* Label the operand at each offset refers to */
+static u_char		hasRefTarget[MAX_MEMORY];		/* Set where refTarget is in use */
+static BOOL			trackLabels = FALSE;			/* Set while labels whose count crosses 0 are kept */
+static u_int16		changedLabels[MAX_MEMORY];		/* Labels whose count crossed 0 */
+static u_int32		changedLabelCount = 0;
+static BOOL			trackListing = FALSE;			/* Set while listingOffset is filled in */
+static u_int32		listingOffset[MAX_MEMORY];		/* Listing offset of each code line and data run */
+static u_int32		listingCodeStart = 0;			/* Listing offset of the first line of the code */
+static u_int32		listingCodeEnd = 0;				/* Listing offset after the last line of the code */
+static u_char		oldTrace[MAX_MEMORY];			/* Tables from before the hints changed */
+static u_char		oldHint[MAX_MEMORY];
+static u_char		oldCode[MAX_MEMORY];
+static u_char		newTrace[MAX_MEMORY];
+static u_char		newHint[MAX_MEMORY];
+static u_char		relabeled[MAX_MEMORY];			/* Labels whose text changed */
+static u_int16		oldLineStart[MAX_MEMORY];		/* Line index from before the hints changed */
+static u_char		oldLineFlags[MAX_MEMORY];
+static UpdateSpan	updateSpans[MAX_UPDATE_SPANS];
+static u_int32		updateSpanCount = 0;
+static UpdateSpan	updateRegions[MAX_UPDATE_SPANS];
+static u_int32		updateRegionCount = 0;
 
 
 static int stackRegBits[8] =
@@ -175,212 +293,340 @@ static int GetRelativeLong(u_char *mem, u_int16 pc)
 
 
 /*************************************************************************** 
-	Initiates a trace into a branch. Works until it gets a return
+	Build the flow class and length of every opcode from the flow field
+	in the opcode tables
 ***************************************************************************/
-static void TraceBranch(u_char *mem, u_int16 pc)
+static void InitOpcodeFlow(void)
 {
-	if(pc >= maxPC)
+	static Opcode *tables[3] = {optable, optable10, optable11};
+	int page;
+	int code;
+
+	if(TRUE == opFlowReady)
 	{
 		return;
 	}
 
-	/*
-		Prevent us from processing a block of code that has already
-		been done
-	*/
-	if(TRACE_DATA == GET_TRACEINFO(pc))
+	for(page = 0; page < 3; page++)
 	{
-		int bytesUsed;
-
-		/* Set the new pc */
-		while(STATE_TRACE == traceState && pc < maxPC)
+		for(code = 0; code < 256; code++)
 		{
-			u_char code = mem[pc];
+			Opcode *op;
 
-			bytesUsed = optable[code].traceFunc(mem, &optable[code], code, pc);
-			if(bytesUsed < 1)
-			{
-				pc = -bytesUsed;
-			}
-			else
-			{
-				pc += bytesUsed;
-			}
+			op = &tables[page][code];
+			opFlow[page][code] = (u_char)op->flow;
+			opBytes[page][code] = (u_char)op->byteCount;
 		}
-
-		/* Reset the return state */
-		traceState = STATE_TRACE;
 	}
+
+	opFlowReady = TRUE;
 }
 
 
 /*************************************************************************** 
+	Decode the instruction at pc into its step
 ***************************************************************************/
-static void EnterTrace(u_char *mem, u_int16 pc)
+static void DecodeStep(u_char *mem, u_int32 pc)
 {
-	traceState = STATE_TRACE;
+	TraceStep *step;
+	u_int32 page;
+	u_int32 at;
+	u_char code;
+	u_char flow;
+
+	/* Page prefixes select the table for the byte after them */
+	code = mem[pc];
+	page = opFlow[0][code] == FLOW_PAGE10 ? 1 : opFlow[0][code] == FLOW_PAGE11 ? 2 : 0;
+	at = pc + (0 != page);
+	code = mem[at];
+	flow = opFlow[page][code];
+
+	step = &traceSteps[pc];
+	step->marked = (u_char)(opBytes[page][code] + (0 != page));
+	step->length = step->marked;
+	step->target = 0;
+
+	switch(flow)
+	{
+	case FLOW_INDEXED:
+		if(0 != (mem[at + 1] & 0x80))
+		{
+			step->length += postOpExtraBytes[mem[at + 1] & 0x1f];
+		}
+		flow = FLOW_NEXT;
+		break;
+
+	case FLOW_BRANCH:
+	case FLOW_JUMP:
+		step->target = GetRelative(mem, (u_int16)at);
+		break;
+
+	case FLOW_BRANCH_LONG:
+	case FLOW_JUMP_LONG:
+		step->target = (u_int16)GetRelativeLong(mem, (u_int16)at);
+		flow = FLOW_BRANCH_LONG == flow ? FLOW_BRANCH : FLOW_JUMP;
+		break;
+
+	case FLOW_PULL:
+		flow = 0 != (mem[at + 1] & SREG_PC) ? FLOW_RETURN : FLOW_NEXT;
+		break;
+
+	case FLOW_PAGE10:
+	case FLOW_PAGE11:
+		/* A prefix after a prefix traces as a single byte */
+		flow = FLOW_NEXT;
+		break;
+	}
 
-	TraceBranch(mem, pc);
+	step->flow = flow;
 }
 
 
 /*************************************************************************** 
+	Decode the instruction at every offset of the code into the step
+	table. Each step is decoded on its own, without regard for where the
+	instructions before it ended, so the tracer only has to follow the
+	steps from its entry points.
 ***************************************************************************/
-int TraceGeneric(u_char *mem, Opcode *op, u_char code, u_int16 pc)
+static void DecodeSteps(u_char *mem, u_int16 size)
 {
-	int i;
+	u_int32 pc;
 
-	for(i = 0; i < op->byteCount; i++)
+	for(pc = 0; pc < size; pc++)
 	{
-		SET_TRACEINFO(pc + i, TRACE_CODE);
+		DecodeStep(mem, pc);
 	}
 
-	return op->byteCount;
-
+	STATS_COUNT(STAT_PREDECODED, size);
 }
 
 
 /*************************************************************************** 
+	Check if the bytes after the first of an instruction run into what the
+	hints say is data
 ***************************************************************************/
-int TraceGenericJmp(u_char *mem, Opcode *op, u_char code, u_int16 pc)
+static BOOL RunsIntoDataHint(u_int32 pc, u_int32 length)
 {
-	return TraceGeneric(mem, op, code, pc);
-}
+	u_int32 end;
 
+	end = pc + length < maxPC ? pc + length : maxPC;
+	for(pc++; pc < end; pc++)
+	{
+		if(IS_DATA_HINT(hintInfo[pc]))
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
 
 
 /*************************************************************************** 
+	Initiates a trace into a branch. Works until it gets a return
 ***************************************************************************/
-int TracePage10(u_char *mem, Opcode *op, u_char code, u_int16 pc)
+static void TraceBranch(u_int16 pc)
 {
-	SET_TRACEINFO(pc++, TRACE_CODE);
-	code = mem[pc];
-	return optable10[code].traceFunc(mem, &optable10[code], code, pc) + 1;
-}
+	if(pc >= maxPC || 0 != traceResult)
+	{
+		return;
+	}
 
+	if(MAX_TRACEDEPTH == traceDepth)
+	{
+		SetError("branches nested too deeply at $%04X", pc);
+		traceResult = -1;
+		return;
+	}
 
-int TracePage11(u_char *mem, Opcode *op, u_char code, u_int16 pc)
-{
-	SET_TRACEINFO(pc++, TRACE_CODE);
-	code = mem[pc];
-	return optable11[code].traceFunc(mem, &optable11[code], code, pc) + 1;
-}
+	/*
+		Prevent us from processing a block of code that has already
+		been done
+	*/
+	if(TRACE_DATA == GET_TRACEINFO(pc))
+	{
+		traceDepth++;
 
+		/* Set the new pc */
+		while(STATE_TRACE == traceState && pc < maxPC && 0 == traceResult)
+		{
+			TraceStep *step;
 
-int TraceIndexed(u_char *mem, Opcode *op, u_char code, u_int16 pc)
-{
-	int postbyte;
-	int extrabytes;
+			/* Never trace into what the hints say is data */
+			if(IS_DATA_HINT(hintInfo[pc]))
+			{
+				break;
+			}
 
-	
-	extrabytes = 0;
-	postbyte = mem[pc + 1];
+			step = &traceSteps[pc];
 
-	if(0 != (postbyte & 0x80))
-	{
-		extrabytes = postOpExtraBytes[postbyte & 0x1f];
-	}
+			/*
+				An instruction that would run into data is left as data so
+				the range of the hint is kept whole
+			*/
+			if(TRUE == hintsPainted && TRUE == RunsIntoDataHint(pc, step->length))
+			{
+				break;
+			}
 
-	TraceGeneric(mem, op, code, pc);
+			if(0 != BudgetInstructions(1))
+			{
+				traceResult = -1;
+				break;
+			}
 
-	return op->byteCount + extrabytes;
-}
+			if(TRACE_DATA == GET_TRACEINFO(pc))
+			{
+				STATS_COUNT(STAT_TRACED_INSNS, 1);
+			}
+			memset(traceInfo + pc, TRACE_CODE, step->marked);
 
+			switch(step->flow)
+			{
+			case FLOW_BRANCH:
+				TraceBranch(step->target);
+				break;
 
-int TraceRelative(u_char *mem, Opcode *op, u_char code, u_int16 pc)
-{
-	int used;
+			case FLOW_JUMP:
+				/* If the new PC already has something, don't go there! */
+				if(TRACE_DATA == GET_TRACEINFO(step->target))
+				{
+					pc = step->target;
+					continue;
+				}
+				break;
+
+			case FLOW_RETURN:
+				traceState = STATE_RETURN;
+				break;
+			}
 
-	used = TraceGeneric(mem, op, code, pc);
+			pc += step->length;
+		}
 
-	TraceBranch(mem, GetRelative(mem, pc));
+		traceDepth--;
 
-	return used;
+		/* Reset the return state */
+		traceState = STATE_TRACE;
+	}
 }
 
 
-int TraceRelativeLong(u_char *mem, Opcode *op, u_char code, u_int16 pc)
+/*************************************************************************** 
+***************************************************************************/
+static void EnterTrace(u_int16 pc)
 {
-	int used;
-
-	used = TraceGeneric(mem, op, code, pc);
-
-	TraceBranch(mem, (u_int16)GetRelativeLong(mem, pc));
+	traceState = STATE_TRACE;
 
-	return used;
+	TraceBranch(pc);
 }
 
 
-int TraceRelativeJump(u_char *mem, Opcode *op, u_char code, u_int16 pc)
+/*************************************************************************** 
+	Find the hints for a module and paint their ranges over its code
+***************************************************************************/
+static void ApplyHints(OS9ROF *rfile)
 {
-	u_int16 newPC;
-	int bytesUsed;
+	u_int32 i;
 
-	bytesUsed = TraceGeneric(mem, op, code, pc);
+	if(TRUE == hintsPainted)
+	{
+		memset(hintInfo, HINT_NONE, MAX_MEMORY);
+		hintsPainted = FALSE;
+	}
 
-	newPC = GetRelative(mem, pc);
+	hintSet = FindHintSet(disasmHints, rfile->name);
+	if(NULL == hintSet)
+	{
+		return;
+	}
 
-	/* If the new PC already has something, don't go there! */
-	if(TRACE_DATA != GET_TRACEINFO(newPC))
+	/* An empty default set changes nothing */
+	if(0 == hintSet->rangeCount && 0 == hintSet->labelCount)
 	{
-		return bytesUsed;
+		hintSet = NULL;
+		return;
 	}
 
-	return -newPC;
+	for(i = 0; i < hintSet->rangeCount; i++)
+	{
+		const HintRange *range;
+		u_int32 end;
+
+		range = &hintSet->ranges[i];
+		if(range->start >= rfile->sizeObjectCode)
+		{
+			continue;
+		}
+
+		end = range->end < rfile->sizeObjectCode ? range->end : rfile->sizeObjectCode - 1;
+		memset(hintInfo + range->start, range->kind, end - range->start + 1);
+		hintsPainted = TRUE;
+	}
 }
 
 
-int TraceRelativeJumpLong(u_char *mem, Opcode *op, u_char code, u_int16 pc)
+/*************************************************************************** 
+	Trace from the entry points, the instructions of the code ranges, and
+	the targets of the jump tables given by the hints
+***************************************************************************/
+static void TraceHints(OS9ROF *rfile)
 {
-	u_int16 newPC;
-	int bytesUsed;
-
-	bytesUsed = TraceGeneric(mem, op, code, pc);
+	u_char *mem;
+	u_int32 i;
 
-	newPC = GetRelativeLong(mem, pc);
+	mem = rfile->objectCode;
 
-	/* If the new PC already has something, don't go there! */
-	if(TRACE_DATA != GET_TRACEINFO(newPC))
+	for(i = 0; i < hintSet->labelCount && 0 == traceResult; i++)
 	{
-		return bytesUsed;
+		if(TRUE == hintSet->labels[i].entry)
+		{
+			EnterTrace(hintSet->labels[i].address);
+		}
 	}
 
-	return -newPC;
-}
-
-
-int TraceReturn(u_char *mem, Opcode *op, u_char code, u_int16 pc)
-{
-	traceState = STATE_RETURN;
+	for(i = 0; i < hintSet->rangeCount && 0 == traceResult; i++)
+	{
+		const HintRange *range;
+		u_int32 pc;
 
-	return TraceGeneric(mem, op, code, pc);
-}
+		range = &hintSet->ranges[i];
+		switch(range->kind)
+		{
+		case HINT_CODE:
+			for(pc = range->start; pc <= range->end && pc < maxPC; pc += traceSteps[pc].length)
+			{
+				EnterTrace((u_int16)pc);
+			}
+			break;
 
+		case HINT_JUMPTABLE:
+			for(pc = range->start; pc < range->end && pc + 1 < maxPC; pc += 2)
+			{
+				EnterTrace((u_int16)((mem[pc] << 8) | mem[pc + 1]));
+			}
+			break;
 
-int TracePullStack(u_char *mem, Opcode *op, u_char code, u_int16 pc)
-{
-	if(mem[pc + 1] & SREG_PC)
-	{
-		traceState = STATE_RETURN;
+		default:
+			break;
+		}
 	}
-
-	return TraceGeneric(mem, op, code, pc);
 }
 
 
-
 /*************************************************************************** 
+	Trace from the globals of the module and the hints. The entry points
+	are traced one after another in list order. A branch into code that
+	is already traced stops and a jump to it falls through, so which bytes
+	end up marked depends on that order and the walk can't be split
+	across threads without changing the listing.
 ***************************************************************************/
-void TraceObjectCode(OS9ROF *rfile)
+static int TraceStarts(OS9ROF *rfile)
 {
 	Node *node;
 	int traced;
 
 	traced = 0;
-	maxPC = rfile->sizeObjectCode;
-
-	/* Reset the disassembler trace info */
-	memset(traceInfo, TRACE_DATA, MAX_MEMORY);
 
 	/* Get the head of the list */
 	node = ListGetHead(rfile->refList);
@@ -393,102 +639,373 @@ void TraceObjectCode(OS9ROF *rfile)
 		ref = NodeGetData(node);
 		if(ref->type == REF_GLOBAL)
 		{
-			EnterTrace(rfile->objectCode, ref->offset);
+			EnterTrace(ref->offset);
 			traced++;
 		}
 
 		node = NodeGetNext(rfile->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
+	}
+
+	if(NULL != hintSet)
+	{
+		TraceHints(rfile);
 	}
 
 	/* FIXME - should we start from the execution point? */
 	/* If no globals were traced, start from the beginning */
 	if(0 == traced)
 	{
-		EnterTrace(rfile->objectCode, 0);
+		EnterTrace(0);
 	}
+
+	return traceResult;
 }
 
 
-static u_int16 getWord(u_char *mem, u_int16 index)
+/*************************************************************************** 
+***************************************************************************/
+static int TraceCode(OS9ROF *rfile)
 {
-	return((mem[index] << 8) | mem[index + 1]);
-}
+	traceDepth = 0;
+	traceResult = 0;
+	maxPC = rfile->sizeObjectCode;
 
-/*
+	/* Decoding may run on a different thread than the loader */
+	BudgetReset();
 
-  Generating a base label
+	if(0 != maxPC && NULL == rfile->objectCode)
+	{
+		SetError("module has no object code");
+		return -1;
+	}
 
-	for BSS:
-		Pointed to by a global reference
-		Pointed to by a local reference
+	/* Reset the disassembler trace info */
+	memset(traceInfo, TRACE_DATA, MAX_MEMORY);
+	ApplyHints(rfile);
 
-	for DATA:
-		Pointed to by a global reference
-		Pointed to by a local reference
+	/* Decode every offset up front so tracing only follows the steps */
+	InitOpcodeFlow();
+	DecodeSteps(rfile->objectCode, maxPC);
 
-	for CODE:
-		Pointer to by a global reference
-		Pointed to by a local reference
-*/
-static Reference *FindDataRef(OS9ROF *rfile, u_int16 addr)
-{
-	Node *node;
-	Reference *ref;
+	return TraceStarts(rfile);
+}
 
-	/* Get the first node of the reference list */
-	node = ListGetHead(rfile->refList);
 
-	while(NULL != node)
-	{
-		/* Get the node data */
-		ref = NodeGetData(node);
+/*************************************************************************** 
+	Trace the module again after the hints change. The steps only depend
+	on the code so they are not decoded again.
+***************************************************************************/
+static int RetraceObjectCode(OS9ROF *rfile)
+{
+	traceDepth = 0;
+	traceResult = 0;
 
-		/* if it's the in code, the right offset, and right type, check it */
-		if(REF_LOCAL == ref->type && addr == ref->offset)
-		{
-			if(0 == (ref->flag & CODLOC))
-			{
-				/*
-					Local references can target code, data, or bss so we need
-					to check them all
-				*/
-				/*if(0 == (ref->flag & CODENT) && 0 != (ref->flag & INIENT))*/
-				{
-					return ref;
-				}
-			}
-		}
+	memset(traceInfo, TRACE_DATA, MAX_MEMORY);
+	ApplyHints(rfile);
 
-		node = NodeGetNext(rfile->refList, node);
-	}
+	return TraceStarts(rfile);
+}
 
-	return NULL;
+
+/*************************************************************************** 
+	Set the hints used for the modules disassembled from now on, NULL for
+	none. The hints have to stay loaded while they are in use.
+***************************************************************************/
+void SetDisasmHints(const Hints *hints)
+{
+	disasmHints = hints;
 }
 
-/* Returns if it should output a reference to something else */
-static void GenBaseLabel(FILE *outFile, OS9ROF *rfile, LABTYPE labelType, u_int16 label)
+
+/*************************************************************************** 
+	Get the length of the instruction at pc from the opcode tables alone.
+	An instruction cut off by the end of the code returns the length it
+	would need.
+***************************************************************************/
+static int InstructionLength(u_char *mem, u_int16 pc, u_int16 size)
 {
-	Node *node;
-	Reference *ref;
+	int page;
 	int length;
-	BOOL labelGenerated;
 
-	if(1 == disasmPass)
+	page = 0;
+	length = 0;
+
+	if(0x10 == mem[pc] || 0x11 == mem[pc])
 	{
-		return;
-	}
+		if(pc + 1 >= size)
+		{
+			return 2;
+		}
 
-	labelGenerated = FALSE;
+		page = mem[pc] - 0x0f;
+		length = 1;
+		pc++;
+	}
 
-	node = ListGetHead(rfile->refList);
+	length += opBytes[page][mem[pc]];
 
-	while(NULL != node)
+	if(FLOW_INDEXED == opFlow[page][mem[pc]] && pc + 1 < size && 0 != (mem[pc + 1] & 0x80))
 	{
+		length += postOpExtraBytes[mem[pc + 1] & 0x1f];
+	}
 
-		ref = NodeGetData(node);
+	return length;
+}
 
-		if(label == ref->offset)
-		{
+
+/*************************************************************************** 
+	Mark the code as instructions from start to finish without following
+	the flow. Only an instruction cut off by the end of the code is left
+	as data. This is a fast replacement for TraceObjectCode when the code
+	and data don't need to be separated accurately.
+***************************************************************************/
+static int SweepCode(OS9ROF *rfile)
+{
+	u_int32 pc;
+	int length;
+
+	maxPC = rfile->sizeObjectCode;
+
+	BudgetReset();
+
+	if(0 != maxPC && NULL == rfile->objectCode)
+	{
+		SetError("module has no object code");
+		return -1;
+	}
+
+	memset(traceInfo, TRACE_DATA, MAX_MEMORY);
+	InitOpcodeFlow();
+
+	for(pc = 0; pc < maxPC; pc += length)
+	{
+		length = InstructionLength(rfile->objectCode, (u_int16)pc, maxPC);
+		if(pc + length > maxPC)
+		{
+			break;
+		}
+
+		memset(traceInfo + pc, TRACE_CODE, length);
+		STATS_COUNT(STAT_TRACED_INSNS, 1);
+	}
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Mark the code of a module as the trace phase and count the bytes
+	that were marked
+***************************************************************************/
+static int RunTrace(int (*trace)(OS9ROF *rfile), OS9ROF *rfile)
+{
+	u_int32 traced;
+	u_int32 pc;
+	int result;
+
+	StatsEnter(PHASE_TRACE);
+	result = trace(rfile);
+
+	if(NULL != statsTarget && 0 == result)
+	{
+		traced = 0;
+		for(pc = 0; pc < maxPC; pc++)
+		{
+			if(TRACE_DATA != GET_TRACEINFO(pc))
+			{
+				traced++;
+			}
+		}
+		STATS_COUNT(STAT_TRACED, traced);
+	}
+
+	StatsLeave();
+
+	return result;
+}
+
+
+int TraceObjectCode(OS9ROF *rfile)
+{
+	return RunTrace(TraceCode, rfile);
+}
+
+
+int SweepObjectCode(OS9ROF *rfile)
+{
+	return RunTrace(SweepCode, rfile);
+}
+
+
+/*************************************************************************** 
+	Count the instructions of a linear sweep over the code without
+	rendering anything. The counts are added to the ones already in
+	stats so a whole archive can be tallied.
+***************************************************************************/
+int SweepStatistics(OS9ROF *rfile, SweepStats *stats)
+{
+	u_char *mem;
+	u_int32 size;
+	u_int32 pc;
+	int length;
+
+	mem = rfile->objectCode;
+	size = rfile->sizeObjectCode;
+
+	if(0 != size && NULL == mem)
+	{
+		SetError("module has no object code");
+		return -1;
+	}
+
+	InitOpcodeFlow();
+
+	for(pc = 0; pc < size; pc += length)
+	{
+		length = InstructionLength(mem, (u_int16)pc, (u_int16)size);
+		if(pc + length > size)
+		{
+			break;
+		}
+
+		if(0x10 == mem[pc] || 0x11 == mem[pc])
+		{
+			stats->opcodes[mem[pc] - 0x0f][mem[pc + 1]]++;
+		}
+		else
+		{
+			stats->opcodes[0][mem[pc]]++;
+		}
+
+		stats->instructions++;
+	}
+
+	stats->modules++;
+	stats->bytes += pc;
+	stats->trailing += size - pc;
+
+	return 0;
+}
+
+
+static u_int16 getWord(u_char *mem, u_int16 index)
+{
+	return((mem[index] << 8) | mem[index + 1]);
+}
+
+/*
+
+  Generating a base label
+
+	for BSS:
+		Pointed to by a global reference
+		Pointed to by a local reference
+
+	for DATA:
+		Pointed to by a global reference
+		Pointed to by a local reference
+
+	for CODE:
+		Pointer to by a global reference
+		Pointed to by a local reference
+*/
+static Reference *FindDataRef(OS9ROF *rfile, u_int16 addr)
+{
+	Node *node;
+	Reference *ref;
+
+	/* Get the first node of the reference list */
+	node = ListGetHead(rfile->refList);
+
+	while(NULL != node)
+	{
+		/* Get the node data */
+		ref = NodeGetData(node);
+
+		/* if it's the in code, the right offset, and right type, check it */
+		if(REF_LOCAL == ref->type && addr == ref->offset)
+		{
+			if(0 == (ref->flag & CODLOC))
+			{
+				/*
+					Local references can target code, data, or bss so we need
+					to check them all
+				*/
+				/*if(0 == (ref->flag & CODENT) && 0 != (ref->flag & INIENT))*/
+				{
+					return ref;
+				}
+			}
+		}
+
+		node = NodeGetNext(rfile->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
+	}
+
+	return NULL;
+}
+
+/*************************************************************************** 
+	Get the name the hints give a code label, NULL if they don't
+***************************************************************************/
+static const char *HintLabelName(u_int16 label)
+{
+	const HintLabel *hint;
+
+	if(NULL == hintSet)
+	{
+		return NULL;
+	}
+
+	hint = FindHintLabel(hintSet, label);
+
+	return NULL != hint ? hint->name : NULL;
+}
+
+
+/*************************************************************************** 
+	Generate a reference to a code label that always uses the L prefix
+	unless the hints name it
+***************************************************************************/
+static int GenNamedCodeLabel(FILE *outFile, u_int16 label)
+{
+	const char *name;
+
+	name = HintLabelName(label);
+	if(NULL != name)
+	{
+		return GenAsm(outFile, "%s", name);
+	}
+
+	return GenAsmLabelCode(outFile, label);
+}
+
+
+/* Returns if it should output a reference to something else */
+static void GenBaseLabel(FILE *outFile, OS9ROF *rfile, LABTYPE labelType, u_int16 label)
+{
+	Node *node;
+	Reference *ref;
+	int length;
+	BOOL labelGenerated;
+
+	if(1 == disasmPass)
+	{
+		return;
+	}
+
+	labelGenerated = FALSE;
+
+	node = ListGetHead(rfile->refList);
+
+	while(NULL != node)
+	{
+
+		ref = NodeGetData(node);
+
+		if(label == ref->offset)
+		{
 
 			switch(labelType)
 			{
@@ -542,6 +1059,7 @@ static void GenBaseLabel(FILE *outFile, OS9ROF *rfile, LABTYPE labelType, u_int1
 		}
 
 		node = NodeGetNext(rfile->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
 	}
 
 
@@ -554,7 +1072,15 @@ static void GenBaseLabel(FILE *outFile, OS9ROF *rfile, LABTYPE labelType, u_int1
 		case LABCODE:			/* location is code, label is in code */
 			if(TRUE == GET_CODEINFO(label))
 			{
-				if(TRUE == GET_TRACEINFO(label))
+				const char *name;
+
+				name = HintLabelName(label);
+				if(NULL != name)
+				{
+					length = GenAsm(outFile, "%s", name);
+					labelGenerated = TRUE;
+				}
+				else if(TRUE == GET_TRACEINFO(label))
 				{
 					length = GenAsmLabelCode(outFile, label);
 					labelGenerated = TRUE;
@@ -590,10 +1116,30 @@ static void GenBaseLabel(FILE *outFile, OS9ROF *rfile, LABTYPE labelType, u_int1
 
 
 
+/*************************************************************************** 
+	Count a reference to a code label from the operand at pc
+***************************************************************************/
+static void CountLabel(u_int16 pc, u_int16 label)
+{
+	labelRefs[label] += labelDelta;
+	refTarget[pc] = label;
+	hasRefTarget[pc] = labelDelta > 0 ? TRUE : FALSE;
+
+	/* Keep the labels that appear or disappear */
+	if(TRUE == trackLabels
+		&& changedLabelCount < MAX_MEMORY
+		&& (labelDelta > 0 ? 1 : 0) == labelRefs[label])
+	{
+		changedLabels[changedLabelCount++] = label;
+	}
+}
+
+
 static void GenCodeLabel(FILE *outFile, OS9ROF *rfile, u_int16 pc, u_int16 label)
 {
 	if(pc > maxPC) 	/* It's outside of the code, just gen a label */
 	{
+		GenAsmReference(ASMREF_ABSOLUTE, label);
 		GenAsmAddress(outFile, label);
 	}
 	else
@@ -621,22 +1167,26 @@ static void GenCodeLabel(FILE *outFile, OS9ROF *rfile, u_int16 pc, u_int16 label
 					*/
 					if(ref->flag & CODENT)
 					{
-						GenAsmLabelCode(outFile, label);
+						GenAsmReference(ASMREF_CODE, label);
+						GenNamedCodeLabel(outFile, label);
 					}
 					else
 					{
 						if(ref->flag & INIENT)
 						{
+							GenAsmReference(ASMREF_DATA, label);
 							GenAsmLabelData(outFile, label);
 						}
 						else
 						{
+							GenAsmReference(ASMREF_BSS, label);
 							GenAsmLabelBSS(outFile, label);
 						}
 					}
 				}
 				else
 				{
+					GenAsmReference(ASMREF_EXTERNAL, label);
 					GenAsm(outFile, ref->symbol);
 				}
 
@@ -644,15 +1194,29 @@ static void GenCodeLabel(FILE *outFile, OS9ROF *rfile, u_int16 pc, u_int16 label
 			}
 
 			node = NodeGetNext(rfile->refList, node);
+			STATS_COUNT(STAT_REFNODES, 1);
 		}
 
-		/* Set that this code location as labeled/accessed */
-		SET_CODEINFO(label, TRUE);
+		if(0 != labelDelta)
+		{
+			CountLabel(pc, label);
+		}
+
+		/*
+			Set that this code location as labeled/accessed. After the
+			first pass it already is, and leaving it alone lets the
+			second pass run on several threads.
+		*/
+		if(FALSE == GET_CODEINFO(label))
+		{
+			SET_CODEINFO(label, TRUE);
+		}
 		
 		/* Generate the proper code label */
-		if(TRUE == GET_TRACEINFO(label))
+		GenAsmReference(ASMREF_CODE, label);
+		if(TRUE == GET_TRACEINFO(label) || NULL != HintLabelName(label))
 		{
-			GenAsmLabelCode(outFile, label);
+			GenNamedCodeLabel(outFile, label);
 		}
 		else
 		{
@@ -714,7 +1278,7 @@ int DisasmPage11(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 pc
 int DisasmIllegal(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 pc)
 {
 	GenAsmOp(outFile, "nop", NULL);
-	GenAsm(outFile, "* [%02X] Illegal instruction", mem[pc]);
+	GenAsmComment(outFile, "* [%02X] Illegal instruction", mem[pc]);
 	return op->byteCount;
 }
 
@@ -819,7 +1383,7 @@ int DisasmIndexed(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 p
 			GenAsm(outFile, ",%s+", IndexRegister(postbyte));
 			if(TRUE == indirect)
 			{
-				GenAsm(outFile, "\t* Invalid indexing mode");
+				GenAsmComment(outFile, "\t* Invalid indexing mode");
 			}
 			break;
 			
@@ -831,7 +1395,7 @@ int DisasmIndexed(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 p
 			GenAsm(outFile, ",-%s", IndexRegister(postbyte));
 			if(TRUE == indirect)
 			{
-				GenAsm(outFile, "\t* Invalid indexing mode");
+				GenAsmComment(outFile, "\t* Invalid indexing mode");
 			}
 			break;
 			
@@ -886,7 +1450,7 @@ int DisasmIndexed(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 p
 			break;
 			
 		case IDX_ILLEGAL2:
-			GenAsm(outFile, "\t* Invalid indexing mode");
+			GenAsmComment(outFile, "\t* Invalid indexing mode");
 			break;
 			
 			
@@ -907,7 +1471,7 @@ int DisasmIndexed(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 p
 			break;
 
 		case IDX_ILLEGAL3:
-			GenAsm(outFile, "\t* Invalid indexing mode");
+			GenAsmComment(outFile, "\t* Invalid indexing mode");
 			break;
 			
 		case IDX_INDIRECT:
@@ -915,7 +1479,7 @@ int DisasmIndexed(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 p
 			GenAsm(outFile, "$%4X", address);
 			if(FALSE == indirect)
 			{
-				GenAsm(outFile, "\t* Invalid indexing mode");
+				GenAsmComment(outFile, "\t* Invalid indexing mode");
 			}
 			break;
 		}
@@ -1053,11 +1617,13 @@ int DisasmOS9SysCall(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int1
 
 	if(post < MAX_OS9CALLS && NULL != os9calls[post].callString)
 	{
-		GenAsm(outFile, "%s\t\t* [$%02X] %s", os9calls[post].callString, post, os9calls[post].callDesc);
+		GenAsm(outFile, "%s", os9calls[post].callString);
+		GenAsmComment(outFile, "\t\t* [$%02X] %s", post, os9calls[post].callDesc);
 	}
 	else
 	{
-		GenAsm(outFile, "$%02x\t\t* Unknown OS-9 system call", post);
+		GenAsm(outFile, "$%02x", post);
+		GenAsmComment(outFile, "\t\t* Unknown OS-9 system call");
 	}
 
 	return op->byteCount;
@@ -1066,6 +1632,65 @@ int DisasmOS9SysCall(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int1
 
 
 
+/*************************************************************************** 
+	Add a line to the line index
+***************************************************************************/
+static void AddLine(u_int16 pc, u_char flags)
+{
+	if(lineCount < MAX_MEMORY)
+	{
+		lineStart[lineCount] = pc;
+		lineFlags[lineCount] = flags;
+		lineCount++;
+	}
+}
+
+
+/*************************************************************************** 
+	Find the bytes of a run of data where the line being generated may
+	have to end. A line of text ends at a byte that can't be in an fcc
+	string. A line of binary ends where two bytes of text start. Both end
+	at labels and, in the initialized data, at references.
+***************************************************************************/
+static void SegmentData(u_char *mem, u_int16 pc, u_int32 count, LABTYPE type)
+{
+	u_int32 words;
+	u_int32 index;
+
+	words = SCAN_WORDS(count);
+
+	ScanText(mem + pc, count, textBreaks, asciiMask);
+
+	/* A binary line ends where a text byte is followed by another */
+	for(index = 0; index < words; index++)
+	{
+		u_int32 next;
+
+		next = (asciiMask[index] >> 1) | (index + 1 < words ? asciiMask[index + 1] << 31 : 0);
+		binaryBreaks[index] = textBreaks[index] & next & 0xffffffffUL;
+		textBreaks[index] = ~textBreaks[index] & 0xffffffffUL;
+	}
+
+	/* Labels and references end both */
+	memset(asciiMask, 0, words * sizeof(u_int32));
+	if(LABDATA == type)
+	{
+		ScanFlags(dataInfo + pc, count, asciiMask);
+		ScanFlags(dataRefInfo + pc, count, asciiMask);
+	}
+	else
+	{
+		ScanFlags(codeInfo + pc, count, asciiMask);
+	}
+
+	for(index = 0; index < words; index++)
+	{
+		textBreaks[index] |= asciiMask[index];
+		binaryBreaks[index] |= asciiMask[index];
+	}
+}
+
+
 /*************************************************************************** 
 
 ***************************************************************************/
@@ -1073,7 +1698,9 @@ static void DumpData(FILE *outFile,
 					 u_char *mem,
 					 u_int16 pc,
 					 u_int16 toDump,
-					 LABTYPE type)
+					 LABTYPE type,
+					 MODE startMode,
+					 u_int32 stop)
 {
 	MODE	mode;
 	MODE	lastMode;
@@ -1081,18 +1708,35 @@ static void DumpData(FILE *outFile,
 	int		totalOut;
 	BOOL	genLabel;
 	Reference *ref;
+	char	values[MAX_FCCLENGTH + MAX_FCBLENGTH * HEX_FCB_WIDTH];	/* Values of the line being built */
+	int		valuesLength;
+	u_char	bytes[MAX_FCBLENGTH];	/* Bytes of the fcb line being built */
+	int		bytesLength;
+	u_int16	start;
+	u_int32	scanned;
+
+	/* Only the bytes up to stop, and the one after it, are looked at */
+	start = pc;
+	scanned = (u_int32)toDump;
+	if(stop < (u_int32)pc + scanned)
+	{
+		scanned = stop > pc ? stop - pc + 1 : 0;
+	}
+	SegmentData(mem, pc, scanned, type);
 
 	count = 0;
 	totalOut = 0;
-	mode = M_BINARY;
-	lastMode = M_BINARY;
+	valuesLength = 0;
+	bytesLength = 0;
+	mode = startMode;
+	lastMode = startMode;
 	ref = NULL;
 
 	/*
 		As long as we are within the code and the location we are processing is
-		data, keep processing.
+		data, keep processing. Stop is always the start of a line.
 	*/
-	while(toDump > 0)
+	while(toDump > 0 && pc < stop)
 	{
 		lastMode = mode;
 
@@ -1124,7 +1768,7 @@ static void DumpData(FILE *outFile,
 		/* Check for using a reference to renerate a target ref */
 		if(LABDATA == type)
 		{
-			ref = FindDataRef(rofFile, pc);
+			ref = TRUE == dataRefInfo[pc] ? FindDataRef(rofFile, pc) : NULL;
 			/* If we find a reference, make the mode binary and reset the count */
 			if(NULL != ref)
 			{
@@ -1154,19 +1798,44 @@ static void DumpData(FILE *outFile,
 		/* If this is the beginning of the data line, do stuff */
 		if(0 == count)
 		{
+			if(0 != bytesLength)
+			{
+				valuesLength = HexFormat(values, bytes, bytesLength, HEX_FCB);
+				bytesLength = 0;
+			}
+
+			if(0 != valuesLength)
+			{
+				GenAsmWrite(outFile, values, valuesLength);
+				valuesLength = 0;
+			}
+
+			/* Data lines count against the decode budget */
+			if(0 != BudgetInstructions(1))
+			{
+				disasmResult = -1;
+				return;
+			}
+
+			if(TRUE == indexLines && LABCODE == type)
+			{
+				AddLine(pc, (0 == totalOut ? LINE_RUNSTART : 0) | (M_TEXT == lastMode ? LINE_TEXTMODE : 0));
+			}
 
 			if(0 != totalOut)
 			{
 				/* If in text mode generate the terminator */
 				if(M_TEXT == lastMode)
 				{
-					GenAsm(outFile, "\"");
+					GenAsmWrite(outFile, "\"\n", 2);
+				}
+				else
+				{
+					GenAsmWrite(outFile, "\n", 1);
 				}
-
-				GenAsm(outFile, "\n");
 			}
 
-			GenAsm(outFile, "%04X:\t", pc);
+			GenAsmAddressPrefix(outFile, pc);
 
 			GenBaseLabel(outFile, rofFile, type, pc);
 
@@ -1174,13 +1843,13 @@ static void DumpData(FILE *outFile,
 			if(M_TEXT == mode)
 			{
 				assert(ref == NULL);
-				GenAsm(outFile, "fcc\t\"");
+				GenAsmWrite(outFile, "fcc\t\"", 5);
 			}
 			else
 			{
 				if(NULL == ref)
 				{
-					GenAsm(outFile, "fcb\t");
+					GenAsmWrite(outFile, "fcb\t", 4);
 				}
 				else
 				{
@@ -1192,7 +1861,7 @@ static void DumpData(FILE *outFile,
 
 					if(ref->flag & CODENT)
 					{
-						GenAsmLabelCode(outFile, addr);
+						GenNamedCodeLabel(outFile, addr);
 					}
 					else
 					{
@@ -1215,17 +1884,14 @@ static void DumpData(FILE *outFile,
 			}
 		}
 
+		/* Values are collected and written once per line */
 		if(M_TEXT == mode)
 		{
-			GenAsm(outFile, "%c", mem[pc]);
+			values[valuesLength++] = (char)mem[pc];
 		}
 		else
 		{
-			if(0 != count)
-			{
-				GenAsm(outFile, ",");
-			}
-			GenAsm(outFile, "$%02x", mem[pc]);
+			bytes[bytesLength++] = mem[pc];
 		}
 
 		count++;
@@ -1248,26 +1914,213 @@ static void DumpData(FILE *outFile,
 		totalOut++;
 		pc++;
 		toDump--;
-	}
 
-	if(0 != totalOut)
-	{
-		if(M_TEXT == mode)
+		/* Add the bytes up to the next one that can end the line */
+		if(0 != count && 0 != toDump && pc < stop && (u_int32)(pc - start) < scanned)
 		{
-			GenAsm(outFile, "\"");
-		}
-		GenAsm(outFile, "\n");
-	}
-}
+			u_int32 run;
+			u_int32 limit;
 
+			run = ScanNext(M_TEXT == mode ? textBreaks : binaryBreaks, pc - start, scanned) - (pc - start);
+			limit = (M_TEXT == mode ? MAX_FCCLENGTH : MAX_FCBLENGTH) - count;
+			run = run < limit ? run : limit;
+			run = run < toDump ? run : toDump;
+			run = run < stop - pc ? run : stop - pc;
 
-/*************************************************************************** 
-
-***************************************************************************/
-static void DisasmDumpData(FILE *outFile, OS9ROF *rfile)
+			if(M_TEXT == mode)
+			{
+				memcpy(values + valuesLength, mem + pc, run);
+				valuesLength += run;
+			}
+			else
+			{
+				memcpy(bytes + bytesLength, mem + pc, run);
+				bytesLength += run;
+			}
+
+			count += run;
+			if((u_int32)count >= (M_TEXT == mode ? MAX_FCCLENGTH : MAX_FCBLENGTH))
+			{
+				count = 0;
+			}
+
+			totalOut += run;
+			pc += (u_int16)run;
+			toDump -= (u_int16)run;
+		}
+	}
+
+	if(0 != bytesLength)
+	{
+		valuesLength = HexFormat(values, bytes, bytesLength, HEX_FCB);
+	}
+
+	if(0 != valuesLength)
+	{
+		GenAsmWrite(outFile, values, valuesLength);
+	}
+
+	if(0 != totalOut)
+	{
+		if(M_TEXT == mode)
+		{
+			GenAsm(outFile, "\"");
+		}
+		GenAsm(outFile, "\n");
+	}
+}
+
+
+/*************************************************************************** 
+	Dump a table of words from the hints one word per line. The words of
+	a jump table are labels in the code.
+***************************************************************************/
+static void DumpWords(FILE *outFile, u_char *mem, u_int16 pc, u_int16 toDump, HINTKIND kind)
+{
+	u_int32 end;
+	u_int16 start;
+
+	start = pc;
+	end = (u_int32)pc + toDump;
+	while(pc < end)
+	{
+		/* Data lines count against the decode budget */
+		if(0 != BudgetInstructions(1))
+		{
+			disasmResult = -1;
+			return;
+		}
+
+		if(TRUE == indexLines)
+		{
+			AddLine(pc, start == pc ? LINE_RUNSTART : 0);
+		}
+
+		GenAsmAddressPrefix(outFile, pc);
+		GenBaseLabel(outFile, rofFile, LABCODE, pc);
+
+		/* An odd byte at the end of the table */
+		if(1 == end - pc)
+		{
+			GenAsm(outFile, "fcb\t$%02x\n", mem[pc]);
+			break;
+		}
+
+		GenAsm(outFile, "fdb\t");
+		if(HINT_JUMPTABLE == kind && getWord(mem, pc) < maxPC)
+		{
+			GenCodeLabel(outFile, rofFile, pc, getWord(mem, pc));
+		}
+		else
+		{
+			GenAsm(outFile, "$%04x", getWord(mem, pc));
+		}
+
+		GenAsm(outFile, "\n");
+		pc += 2;
+	}
+}
+
+
+/*************************************************************************** 
+	Dump a run of untraced bytes in the code the way the hints describe
+	it. Tables are dumped as words.
+***************************************************************************/
+static void DumpRun(FILE *outFile,
+					u_char *mem,
+					u_int16 pc,
+					u_int16 toDump,
+					HINTKIND kind,
+					MODE startMode,
+					u_int32 stop)
+{
+	switch(kind)
+	{
+	case HINT_WORDS:
+	case HINT_JUMPTABLE:
+		DumpWords(outFile, mem, pc, (u_int16)(stop - pc), kind);
+		break;
+
+	default:
+		DumpData(outFile, mem, pc, toDump, LABCODE, startMode, stop);
+		break;
+	}
+}
+
+
+/*************************************************************************** 
+	Pass the captured lines to every sink in the chain. Each sink writes
+	to its own output buffer if it has one.
+***************************************************************************/
+static void SinkModule(FILE *outFile, OS9ROF *rfile)
+{
+	RecordSink *sink;
+	TextBuf *listing;
+
+	listing = GetAsmOutputBuffer();
+	for(sink = recordSink; NULL != sink; sink = sink->next)
+	{
+		SetAsmOutputBuffer(NULL != sink->output ? sink->output : listing);
+		sink->module(sink, outFile, rfile);
+	}
+	SetAsmOutputBuffer(listing);
+}
+
+
+static void SinkInstruction(FILE *outFile, const AsmRecord *record, const u_char *bytes)
+{
+	RecordSink *sink;
+	TextBuf *listing;
+
+	listing = GetAsmOutputBuffer();
+	for(sink = recordSink; NULL != sink; sink = sink->next)
+	{
+		SetAsmOutputBuffer(NULL != sink->output ? sink->output : listing);
+		sink->instruction(sink, outFile, record, bytes);
+	}
+	SetAsmOutputBuffer(listing);
+}
+
+
+static void SinkData(FILE *outFile, int section, const u_char *bytes, u_int16 address, u_int16 length)
+{
+	RecordSink *sink;
+	TextBuf *listing;
+
+	listing = GetAsmOutputBuffer();
+	for(sink = recordSink; NULL != sink; sink = sink->next)
+	{
+		SetAsmOutputBuffer(NULL != sink->output ? sink->output : listing);
+		sink->data(sink, outFile, section, bytes, address, length);
+	}
+	SetAsmOutputBuffer(listing);
+}
+
+
+static void SinkEnd(FILE *outFile)
+{
+	RecordSink *sink;
+	TextBuf *listing;
+
+	listing = GetAsmOutputBuffer();
+	for(sink = recordSink; NULL != sink; sink = sink->next)
+	{
+		SetAsmOutputBuffer(NULL != sink->output ? sink->output : listing);
+		sink->end(sink, outFile);
+	}
+	SetAsmOutputBuffer(listing);
+}
+
+
+/*************************************************************************** 
+
+***************************************************************************/
+static void DisasmDumpData(FILE *outFile, OS9ROF *rfile)
 {
 	u_int16 loc;
 
+	StatsEnter(PHASE_DATA);
+
 	// Dump the unitialized data
 	if(0 != rfile->sizeUninitData)
 	{
@@ -1291,7 +2144,7 @@ static void DisasmDumpData(FILE *outFile, OS9ROF *rfile)
 				while(loc < rfile->sizeUninitData && FALSE == GET_BSSINFO(loc));
 
 
-				GenAsm(outFile, "%04X:\t", label);
+				GenAsmAddressPrefix(outFile, label);
 				GenBaseLabel(outFile, rfile, LABBSS, label);
 				GenAsm(outFile, "rmb\t%$%x\n", size);
 			}
@@ -1308,11 +2161,16 @@ static void DisasmDumpData(FILE *outFile, OS9ROF *rfile)
 	{
 		GenAsm(outFile, "*\n* Initialized data ($%04x)\n*\n", rfile->sizeInitData);
 		GenAsm(outFile, "\tvsect\n");
-		DumpData(outFile, rfile->initData, 0, rfile->sizeInitData, LABDATA);
+		DumpData(outFile, rfile->initData, 0, rfile->sizeInitData, LABDATA, M_BINARY, rfile->sizeInitData);
+		if(TRUE == recording)
+		{
+			SinkData(outFile, SECTION_DATA, rfile->initData, 0, rfile->sizeInitData);
+		}
 		GenAsm(outFile, "\tendsect\n");
 		GenAsm(outFile, "*\n*\n");
 	}
 
+	StatsLeave();
 }
 
 
@@ -1321,6 +2179,12 @@ static void DisasmDumpData(FILE *outFile, OS9ROF *rfile)
 ***************************************************************************/
 static int DisasmDecode(FILE *outFile, u_char *mem)
 {
+	if(0 != disasmResult || 0 != BudgetInstructions(1))
+	{
+		disasmResult = -1;
+		return -1;
+	}
+
 	if(xxPC < maxPC)
 	{
 		u_char	code;
@@ -1329,35 +2193,68 @@ static int DisasmDecode(FILE *outFile, u_char *mem)
 
 		if(TRACE_DATA != GET_TRACEINFO(xxPC))
 		{
+			if(TRUE == indexLines)
+			{
+				AddLine(xxPC, 0);
+			}
+
+			u_int16 pc;
+
+			pc = xxPC;
+
 			// Print the location
-			GenAsm(outFile, "%04X:\t", xxPC);
+			GenAsmAddressPrefix(outFile, xxPC);
+
+			if(TRUE == recording)
+			{
+				BeginAsmRecord(pc);
+			}
 
 			/* Generate a base label for this location */
 			GenBaseLabel(outFile, rofFile, LABCODE, xxPC);
 
 			/* Go process the opcode */
 			xxPC += optable[code].disasmFunc(outFile, mem, &optable[code], code, xxPC);
+			if(2 == disasmPass)
+			{
+				STATS_COUNT(STAT_EMITTED_INSNS, 1);
+			}
 
 			GenAsm(outFile, "\n");
+
+			if(TRUE == recording)
+			{
+				EndAsmRecord();
+				asmRecord.length = xxPC - pc;
+				SinkInstruction(outFile, &asmRecord, mem + pc);
+			}
 		}
 		else
 		{
 			u_int16 pc;
 			u_int16 count;
+			HINTKIND kind;
 
 			GenAsm(outFile, "*\n");
 
 			pc = xxPC;
+			kind = hintInfo[pc];
 
+			/* A run of data ends where the hints change what it holds */
 			count = 0;
-			while(TRACE_DATA == GET_TRACEINFO(xxPC) && xxPC < maxPC)
+			while(TRACE_DATA == GET_TRACEINFO(xxPC) && xxPC < maxPC && kind == hintInfo[xxPC])
 			{
 				count++;
 				xxPC++;
 			}
 
-			DumpData(outFile, mem, pc, count, LABCODE);
+			DumpRun(outFile, mem, pc, count, kind, HINT_STRING == kind ? M_TEXT : M_BINARY, (u_int32)pc + count);
 			GenAsm(outFile, "*\n");
+
+			if(TRUE == recording)
+			{
+				SinkData(outFile, SECTION_CODE, mem + pc, pc, count);
+			}
 		}
 	}
 
@@ -1365,6 +2262,27 @@ static int DisasmDecode(FILE *outFile, u_char *mem)
 }
 
 
+/*************************************************************************** 
+	Generate the title and the sections at the start of the listing
+***************************************************************************/
+static void DisasmTitle(FILE *outFile)
+{
+	GenAsm(outFile, "\n*\n*\t%s\n*\n*\n", rofFile->name);
+}
+
+
+static void DisasmPreamble(FILE *outFile, OS9ROF *rfile)
+{
+	/* Output the preamble stuff */
+	GenAsm(outFile, "*\n");
+	GenAsm(outFile, "\tpsect %s\n", rfile->name);
+	GenAsm(outFile, "*\n*\n\tvsect\n");
+
+	/* Dump the data */
+	DisasmDumpData(outFile, rfile);
+}
+
+
 /*************************************************************************** 
 
 ***************************************************************************/
@@ -1376,11 +2294,18 @@ static void DisasmSetPass(FILE *outFile, int pass)
 
 	if(2 == pass)
 	{
+		recording = NULL != recordSink ? TRUE : FALSE;
+		if(TRUE == recording)
+		{
+			SinkModule(outFile, rofFile);
+		}
+
 		SetAsmOutputMode(TRUE);
-		GenAsm(outFile, "\n*\n*\t%s\n*\n*\n", rofFile->name);
+		DisasmTitle(outFile);
 	}
 	else
 	{
+		recording = FALSE;
 		SetAsmOutputMode(FALSE);
 	}
 }
@@ -1389,16 +2314,18 @@ static void DisasmSetPass(FILE *outFile, int pass)
 /*************************************************************************** 
 
 ***************************************************************************/
-static void DisasmReset(FILE *outFile, OS9ROF *rof, int max)
+static int DisasmReset(FILE *outFile, OS9ROF *rof, int max)
 {
 	Node *node;
 
 	rofFile = rof;
 	maxPC = max;
+	disasmResult = 0;
 
 	memset(codeInfo, 0, MAX_MEMORY);
 	memset(dataInfo, 0, MAX_MEMORY);
 	memset(bssInfo, 0, MAX_MEMORY);
+	memset(dataRefInfo, 0, MAX_MEMORY);
 
 	/* Set up reference information */
 	node = ListGetHead(rof->refList);
@@ -1454,7 +2381,15 @@ static void DisasmReset(FILE *outFile, OS9ROF *rof, int max)
 		case REF_LOCAL:
 			if(0 != (ref->flag & CODLOC))
 			{	/* code */
-				u_int16 address = getWord(rof->objectCode, ref->offset);
+				u_int16 address;
+
+				if(NULL == rof->objectCode || ref->offset >= rof->sizeObjectCode)
+				{
+					SetError("local reference at $%04X is outside of the code", ref->offset);
+					return -1;
+				}
+
+				address = getWord(rof->objectCode, ref->offset);
 
 				TRACE_RESET(("local code: at %04X points to ", ref->offset));
 
@@ -1482,7 +2417,16 @@ static void DisasmReset(FILE *outFile, OS9ROF *rof, int max)
 			else
 			{	/* data */
 				/* Check for references to code */
-				u_int16 address = getWord(rof->initData, ref->offset);
+				u_int16 address;
+
+				if(NULL == rof->initData || ref->offset >= rof->sizeInitData)
+				{
+					SetError("local reference at $%04X is outside of the data", ref->offset);
+					return -1;
+				}
+
+				address = getWord(rof->initData, ref->offset);
+				dataRefInfo[ref->offset] = TRUE;
 
 				TRACE_RESET(("local data: at %04X points to ", ref->offset));
 
@@ -1515,40 +2459,1112 @@ static void DisasmReset(FILE *outFile, OS9ROF *rof, int max)
 		}
 	
 		node = NodeGetNext(rof->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
+	}
+
+	/* Keep the labels of the references for DisasmUpdateHints */
+	if(0 != labelDelta)
+	{
+		memcpy(labelBase, codeInfo, MAX_MEMORY);
+		memset(labelRefs, 0, sizeof(labelRefs));
+		memset(hasRefTarget, 0, MAX_MEMORY);
+	}
+
+	/* Every label in the hints is generated */
+	ApplyHints(rof);
+	if(NULL != hintSet)
+	{
+		u_int32 i;
+
+		for(i = 0; i < hintSet->labelCount; i++)
+		{
+			if(hintSet->labels[i].address < maxPC)
+			{
+				SET_CODEINFO(hintSet->labels[i].address, TRUE);
+			}
+		}
 	}
 
 	DisasmSetPass(outFile, 1);
+
+	return 0;
 }
 
 
 /*************************************************************************** 
 
 ***************************************************************************/
-void DisasmObjectCode(FILE *outFile, OS9ROF *rfile)
+static int DisasmFirstPass(FILE *outFile, OS9ROF *rfile)
 {
+	int result;
+
+	StatsEnter(PHASE_PASS1);
+
 	/* Reset the disassembler */
-	DisasmReset(outFile, rfile, rfile->sizeObjectCode);
+	result = DisasmReset(outFile, rfile, rfile->sizeObjectCode);
 
 	/* Disassemble on the first pass */
+	if(0 == result)
+	{
+		while(0 == DisasmDecode(outFile, rfile->objectCode));
+		result = 0 != disasmResult ? -1 : 0;
+	}
+
+	StatsLeave();
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Index the lines of the code after the first pass
+***************************************************************************/
+static int DisasmIndexLines(FILE *outFile, OS9ROF *rfile)
+{
+	StatsEnter(PHASE_PASS1);
+
+	xxPC = 0;
+	lineCount = 0;
+	indexLines = TRUE;
 	while(0 == DisasmDecode(outFile, rfile->objectCode));
+	indexLines = FALSE;
+
+	StatsLeave();
+
+	return 0 != disasmResult ? -1 : 0;
+}
+
+
+/*************************************************************************** 
+	Run the first pass and index the lines of the code so lines can be
+	generated individually with DisasmLine and DisasmRange.
+
+	The index is built on a separate silent pass because labels found
+	late in the first pass can split data lines that were already passed.
+***************************************************************************/
+int DisasmPrepare(FILE *outFile, OS9ROF *rfile)
+{
+	int result;
+
+	labelDelta = 1;
+	result = DisasmFirstPass(outFile, rfile);
+	labelDelta = 0;
+
+	if(0 != result || 0 != DisasmIndexLines(outFile, rfile))
+	{
+		return -1;
+	}
 
 	/* Set to the second pass */
 	DisasmSetPass(outFile, 2);
 
+	return 0;
+}
+
 
-	/* Output the preamble stuff */
-	GenAsm(outFile, "*\n");
-	GenAsm(outFile, "\tpsect %s\n", rfile->name);
-	GenAsm(outFile, "*\n*\n\tvsect\n");
+/*************************************************************************** 
+	Find the indexed line containing pc
+***************************************************************************/
+static u_int32 FindLine(u_int16 pc)
+{
+	u_int32 low;
+	u_int32 high;
 
-	/* Dump the data */
-	DisasmDumpData(outFile, rfile);
+	low = 0;
+	high = lineCount;
+	while(high - low > 1)
+	{
+		u_int32 mid;
 
-	/* Disassemble the file */
-	while(0 == DisasmDecode(outFile, rfile->objectCode));
+		mid = (low + high) / 2;
+		if(lineStart[mid] <= pc)
+		{
+			low = mid;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+
+/*************************************************************************** 
+	Generate the lines after DisasmPrepare that overlap the addresses from
+	start up to but not including end. Only the lines in the range are
+	decoded.
+***************************************************************************/
+int DisasmRange(FILE *outFile, u_int16 start, u_int16 end)
+{
+	u_char *mem;
+	u_int32 line;
+
+	mem = rofFile->objectCode;
+
+	line = FindLine(start);
+	while(line < lineCount && lineStart[line] < end && 0 == disasmResult)
+	{
+		u_int16 pc;
+
+		pc = lineStart[line];
+		if(TRUE == trackListing)
+		{
+			listingOffset[pc] = GetAsmOutputBuffer()->length;
+		}
+
+		if(TRACE_DATA != GET_TRACEINFO(pc))
+		{
+			xxPC = pc;
+			DisasmDecode(outFile, mem);
+			line++;
+		}
+		else
+		{
+			u_int32 last;
+			u_int32 stop;
+			BOOL more;
+
+			/* Find the last line of this run of data in the range */
+			last = line;
+			while(last + 1 < lineCount
+				&& lineStart[last + 1] < end
+				&& TRACE_DATA == GET_TRACEINFO(lineStart[last + 1])
+				&& 0 == (lineFlags[last + 1] & LINE_RUNSTART))
+			{
+				last++;
+			}
+
+			stop = last + 1 < lineCount ? lineStart[last + 1] : maxPC;
+			more = last + 1 < lineCount
+				&& TRACE_DATA == GET_TRACEINFO(stop)
+				&& 0 == (lineFlags[last + 1] & LINE_RUNSTART);
+
+			if(0 != (lineFlags[line] & LINE_RUNSTART))
+			{
+				GenAsm(outFile, "*\n");
+			}
+
+			/*
+				When the run continues past the range one more byte is
+				included in the count so the data mode is chosen as it
+				is for the whole run.
+			*/
+			DumpRun(outFile,
+					mem,
+					pc,
+					(u_int16)(stop - pc + (TRUE == more ? 1 : 0)),
+					hintInfo[pc],
+					0 != (lineFlags[line] & LINE_TEXTMODE) ? M_TEXT : M_BINARY,
+					stop);
+
+			if(FALSE == more)
+			{
+				GenAsm(outFile, "*\n");
+			}
+
+			line = last + 1;
+		}
+	}
+
+	return disasmResult;
+}
+
+
+/*************************************************************************** 
+	Generate the line at pc after DisasmPrepare. A line is either a
+	single instruction or a run of untraced bytes in the code.
+***************************************************************************/
+int DisasmLine(FILE *outFile, u_int16 pc, DisasmLineInfo *line)
+{
+	if(pc >= maxPC)
+	{
+		return -1;
+	}
+
+	xxPC = pc;
+	DisasmDecode(outFile, rofFile->objectCode);
+	if(0 != disasmResult)
+	{
+		return -1;
+	}
+
+	line->address = pc;
+	line->length = xxPC - pc;
+	line->code = TRACE_DATA != GET_TRACEINFO(pc) ? TRUE : FALSE;
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Render the listing of the module after DisasmPrepare into a buffer
+	and keep where its lines are so DisasmUpdateHints can replace the
+	ones that change.
+***************************************************************************/
+int DisasmRenderListing(TextBuf *listing)
+{
+	TextBuf *output;
+
+	StatsEnter(PHASE_PASS2);
+
+	output = GetAsmOutputBuffer();
+	TextBufReset(listing);
+	SetAsmOutputBuffer(listing);
+
+	DisasmTitle(NULL);
+	DisasmPreamble(NULL, rofFile);
+
+	listingCodeStart = listing->length;
+	trackListing = TRUE;
+	DisasmRange(NULL, 0, maxPC);
+	trackListing = FALSE;
+	listingCodeEnd = listing->length;
+
+	GenAsm(NULL, "*\n\tendsect\n");
+
+	SetAsmOutputBuffer(output);
+
+	StatsLeave();
+
+	return disasmResult;
+}
+
+
+/*************************************************************************** 
+	Add a span of changed addresses. When there are too many they are
+	all merged into one.
+***************************************************************************/
+static void AddUpdateSpan(u_int16 start, u_int16 last)
+{
+	if(MAX_UPDATE_SPANS == updateSpanCount)
+	{
+		u_int32 i;
+
+		for(i = 1; i < updateSpanCount; i++)
+		{
+			updateSpans[0].start = updateSpans[i].start < updateSpans[0].start ? updateSpans[i].start : updateSpans[0].start;
+			updateSpans[0].end = updateSpans[i].end > updateSpans[0].end ? updateSpans[i].end : updateSpans[0].end;
+		}
+
+		updateSpanCount = 1;
+	}
+
+	updateSpans[updateSpanCount].start = start;
+	updateSpans[updateSpanCount].end = last;
+	updateSpanCount++;
+}
+
+
+static int CompareSpans(const void *a, const void *b)
+{
+	const UpdateSpan *left;
+	const UpdateSpan *right;
+
+	left = a;
+	right = b;
+
+	return (int)left->start - (int)right->start;
+}
+
+
+/*************************************************************************** 
+	Add the spans of the code where the trace or the hints changed
+***************************************************************************/
+#define TRACE_CHANGED(pc)	(traceInfo[pc] != oldTrace[pc] || hintInfo[pc] != oldHint[pc])
+
+static void FindTraceChanges(void)
+{
+	u_int32 pc;
+
+	pc = 0;
+	while(pc < maxPC)
+	{
+		u_int32 last;
+		u_int32 next;
+
+		/* Skip unchanged blocks whole */
+		if(pc + 64 <= maxPC
+			&& 0 == memcmp(traceInfo + pc, oldTrace + pc, 64)
+			&& 0 == memcmp(hintInfo + pc, oldHint + pc, 64))
+		{
+			pc += 64;
+			continue;
+		}
+
+		if(!TRACE_CHANGED(pc))
+		{
+			pc++;
+			continue;
+		}
+
+		/* Changes a few bytes apart go in the same span */
+		last = pc;
+		for(next = pc + 1; next < maxPC && next <= last + 16; next++)
+		{
+			if(TRACE_CHANGED(next))
+			{
+				last = next;
+			}
+		}
+
+		AddUpdateSpan((u_int16)pc, (u_int16)last);
+		pc = last + 1;
+	}
+}
+
+
+/*************************************************************************** 
+	Check that pc starts a line of code in the index from before the
+	hints changed
+***************************************************************************/
+static BOOL IsOldCodeLine(u_int32 pc)
+{
+	u_int32 line;
+
+	if(0 == lineCount || TRACE_DATA == oldTrace[pc] || TRACE_DATA == traceInfo[pc])
+	{
+		return FALSE;
+	}
+
+	line = FindLine((u_int16)pc);
+
+	return pc == lineStart[line] ? TRUE : FALSE;
+}
+
+
+/*************************************************************************** 
+	Turn the changed spans into the regions of lines that have to be
+	generated again. A region starts at a line of code or the start of a
+	run of data before the change, which is the same with the old and the
+	new hints, and ends at the first line of code after it that is also
+	a line with the old hints. Everything outside the regions is left as
+	it was.
+***************************************************************************/
+static int FindUpdateRegions(u_char *mem)
+{
+	u_int32 span;
+
+	qsort(updateSpans, updateSpanCount, sizeof(UpdateSpan), CompareSpans);
+
+	updateRegionCount = 0;
+	span = 0;
+	while(span < updateSpanCount)
+	{
+		u_int32 line;
+		u_int32 last;
+		u_int16 start;
+
+		/* Back up to a line before the change that starts code or data */
+		line = FindLine(0 == updateSpans[span].start ? 0 : updateSpans[span].start - 1);
+		while(line > 0 && TRACE_DATA == oldTrace[lineStart[line]] && 0 == (lineFlags[line] & LINE_RUNSTART))
+		{
+			line--;
+		}
+
+		start = 0 == lineCount ? 0 : lineStart[line];
+		last = updateSpans[span].end;
+		span++;
+
+		/* Decode forward until the old and new lines meet again */
+		xxPC = start;
+		for(;;)
+		{
+			if(xxPC >= maxPC)
+			{
+				span = updateSpanCount;
+				break;
+			}
+
+			if(xxPC > last && TRUE == IsOldCodeLine(xxPC))
+			{
+				if(span < updateSpanCount && updateSpans[span].start <= xxPC)
+				{
+					last = updateSpans[span].end > last ? updateSpans[span].end : last;
+					span++;
+					continue;
+				}
+
+				break;
+			}
+
+			DisasmDecode(NULL, mem);
+			if(0 != disasmResult)
+			{
+				return -1;
+			}
+		}
+
+		/* Regions that touch are generated together */
+		if(0 != updateRegionCount && updateRegions[updateRegionCount - 1].end >= start)
+		{
+			updateRegions[updateRegionCount - 1].end = xxPC < maxPC ? xxPC : maxPC;
+		}
+		else
+		{
+			updateRegions[updateRegionCount].start = start;
+			updateRegions[updateRegionCount].end = xxPC < maxPC ? xxPC : maxPC;
+			updateRegionCount++;
+		}
+	}
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Run the first pass over the regions to add or remove the labels
+	their operands refer to
+***************************************************************************/
+static int CountRegionLabels(u_char *mem, int delta)
+{
+	u_int32 i;
+
+	labelDelta = delta;
+	for(i = 0; i < updateRegionCount && 0 == disasmResult; i++)
+	{
+		xxPC = updateRegions[i].start;
+		while(xxPC < updateRegions[i].end && 0 == disasmResult)
+		{
+			DisasmDecode(NULL, mem);
+		}
+	}
+	labelDelta = 0;
+
+	return disasmResult;
+}
+
+
+/*************************************************************************** 
+	Set whether an address is labeled from the references, the operands
+	referring to it, and the hints. Returns TRUE if that changed.
+***************************************************************************/
+static BOOL UpdateLabel(u_int16 label)
+{
+	BOOL labeled;
+
+	labeled = TRUE == labelBase[label] || 0 != labelRefs[label] ? TRUE : FALSE;
+	if(FALSE == labeled && NULL != hintSet && label < maxPC && NULL != FindHintLabel(hintSet, label))
+	{
+		labeled = TRUE;
+	}
+
+	SET_CODEINFO(label, labeled);
+
+	return oldCode[label] != labeled ? TRUE : FALSE;
+}
+
+
+/*************************************************************************** 
+	Mark a label whose line or references change
+***************************************************************************/
+static void RelabelAddress(u_int16 label, BOOL renamed)
+{
+	if(label < maxPC)
+	{
+		AddUpdateSpan(label, label);
+	}
+
+	if(TRUE == renamed)
+	{
+		relabeled[label] = TRUE;
+	}
+}
+
+
+/*************************************************************************** 
+	Find the labels that appeared, disappeared, or were renamed and add
+	spans for their lines and the operands that refer to them
+***************************************************************************/
+static void FindLabelChanges(OS9ROF *rfile, const HintSet *oldSet)
+{
+	const HintLabel *oldLabels;
+	const HintLabel *newLabels;
+	u_int32 oldCount;
+	u_int32 newCount;
+	u_int32 i;
+	u_int32 j;
+	u_int32 pc;
+	Node *node;
+
+	/* Labels whose count crossed 0 */
+	if(MAX_MEMORY == changedLabelCount)
+	{
+		for(pc = 0; pc < MAX_MEMORY; pc++)
+		{
+			if(TRUE == UpdateLabel((u_int16)pc))
+			{
+				RelabelAddress((u_int16)pc, FALSE);
+			}
+		}
+	}
+	else
+	{
+		for(i = 0; i < changedLabelCount; i++)
+		{
+			if(TRUE == UpdateLabel(changedLabels[i]))
+			{
+				RelabelAddress(changedLabels[i], FALSE);
+			}
+		}
+	}
+
+	/* Labels added, removed, or renamed by the hints */
+	oldLabels = NULL != oldSet ? oldSet->labels : NULL;
+	oldCount = NULL != oldSet ? oldSet->labelCount : 0;
+	newLabels = NULL != hintSet ? hintSet->labels : NULL;
+	newCount = NULL != hintSet ? hintSet->labelCount : 0;
+	i = 0;
+	j = 0;
+	while(i < oldCount || j < newCount)
+	{
+		const HintLabel *oldLabel;
+		const HintLabel *newLabel;
+		u_int16 label;
+
+		oldLabel = i < oldCount ? &oldLabels[i] : NULL;
+		newLabel = j < newCount ? &newLabels[j] : NULL;
+		if(NULL == newLabel || (NULL != oldLabel && oldLabel->address < newLabel->address))
+		{
+			label = oldLabel->address;
+			newLabel = NULL;
+			i++;
+		}
+		else if(NULL == oldLabel || newLabel->address < oldLabel->address)
+		{
+			label = newLabel->address;
+			oldLabel = NULL;
+			j++;
+		}
+		else
+		{
+			label = oldLabel->address;
+			i++;
+			j++;
+		}
+
+		UpdateLabel(label);
+		if(NULL == oldLabel || NULL == newLabel
+			|| (NULL == oldLabel->name) != (NULL == newLabel->name)
+			|| (NULL != oldLabel->name && 0 != strcmp(oldLabel->name, newLabel->name)))
+		{
+			RelabelAddress(label, TRUE);
+		}
+		else if(oldCode[label] != GET_CODEINFO(label))
+		{
+			RelabelAddress(label, FALSE);
+		}
+	}
+
+	/* Labels that became code or data change every reference */
+	for(pc = 0; pc < maxPC; pc++)
+	{
+		if(oldTrace[pc] != traceInfo[pc] && TRUE == GET_CODEINFO(pc))
+		{
+			relabeled[pc] = TRUE;
+		}
+	}
+
+	/* Operands referring to the labels whose text changed */
+	for(pc = 0; pc < maxPC; pc++)
+	{
+		if(TRUE == hasRefTarget[pc] && TRUE == relabeled[refTarget[pc]])
+		{
+			AddUpdateSpan((u_int16)pc, (u_int16)pc);
+		}
+	}
+
+	/* Local references in the code name their labels too */
+	node = ListGetHead(rfile->refList);
+	while(NULL != node)
+	{
+		Reference *ref;
+
+		ref = NodeGetData(node);
+		if(REF_LOCAL == ref->type
+			&& 0 != (ref->flag & CODLOC)
+			&& 0 != (ref->flag & CODENT)
+			&& TRUE == relabeled[getWord(rfile->objectCode, ref->offset)])
+		{
+			AddUpdateSpan(ref->offset, ref->offset);
+		}
+
+		node = NodeGetNext(rfile->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
+	}
+
+	memset(relabeled, 0, MAX_MEMORY);
+}
+
+
+/*************************************************************************** 
+	Index the lines of the regions again, keeping the lines between them
+***************************************************************************/
+static int IndexRegions(u_char *mem)
+{
+	u_int32 oldCount;
+	u_int32 next;
+	u_int32 i;
+
+	oldCount = lineCount;
+	memcpy(oldLineStart, lineStart, oldCount * sizeof(u_int16));
+	memcpy(oldLineFlags, lineFlags, oldCount);
+
+	lineCount = 0;
+	next = 0;
+	for(i = 0; i < updateRegionCount; i++)
+	{
+		while(next < oldCount && oldLineStart[next] < updateRegions[i].start)
+		{
+			AddLine(oldLineStart[next], oldLineFlags[next]);
+			next++;
+		}
+
+		while(next < oldCount && oldLineStart[next] < updateRegions[i].end)
+		{
+			next++;
+		}
+
+		indexLines = TRUE;
+		xxPC = updateRegions[i].start;
+		while(xxPC < updateRegions[i].end && 0 == disasmResult)
+		{
+			DisasmDecode(NULL, mem);
+		}
+		indexLines = FALSE;
+	}
+
+	while(next < oldCount)
+	{
+		AddLine(oldLineStart[next], oldLineFlags[next]);
+		next++;
+	}
+
+	return disasmResult;
+}
+
+
+/*************************************************************************** 
+	Generate the regions again and put them in place of their old lines
+	in the listing. The title and the data sections are small and are
+	always generated again.
+***************************************************************************/
+static int RenderRegions(TextBuf *listing)
+{
+	TextBuf *output;
+	TextBuf text;
+	int i;
+
+	output = GetAsmOutputBuffer();
+	TextBufInit(&text);
+
+	/* From the end so the offsets of the regions not done yet still hold */
+	for(i = (int)updateRegionCount - 1; i >= 0 && 0 == disasmResult; i--)
+	{
+		u_int32 start;
+		u_int32 end;
+		u_int32 line;
+		long delta;
+
+		start = listingOffset[updateRegions[i].start];
+		end = updateRegions[i].end < maxPC ? listingOffset[updateRegions[i].end] : listingCodeEnd;
+
+		TextBufReset(&text);
+		SetAsmOutputBuffer(&text);
+		trackListing = TRUE;
+		DisasmRange(NULL, updateRegions[i].start, (u_int16)updateRegions[i].end);
+		trackListing = FALSE;
+
+		if(0 != TextBufReplace(listing, start, end, NULL != text.text ? text.text : "", text.length))
+		{
+			SetError("out of memory");
+			disasmResult = -1;
+			break;
+		}
+
+		/* Move the lines of the region and the ones after it */
+		delta = (long)text.length - (long)(end - start);
+		for(line = FindLine(updateRegions[i].start); line < lineCount; line++)
+		{
+			if(lineStart[line] < updateRegions[i].end)
+			{
+				listingOffset[lineStart[line]] += start;
+			}
+			else
+			{
+				listingOffset[lineStart[line]] += delta;
+			}
+		}
+		listingCodeEnd += delta;
+	}
+
+	if(0 == disasmResult)
+	{
+		u_int32 line;
+		long delta;
+
+		TextBufReset(&text);
+		SetAsmOutputBuffer(&text);
+		DisasmTitle(NULL);
+		DisasmPreamble(NULL, rofFile);
+
+		if(0 != TextBufReplace(listing, 0, listingCodeStart, NULL != text.text ? text.text : "", text.length))
+		{
+			SetError("out of memory");
+			disasmResult = -1;
+		}
+		else
+		{
+			delta = (long)text.length - (long)listingCodeStart;
+			for(line = 0; line < lineCount; line++)
+			{
+				listingOffset[lineStart[line]] += delta;
+			}
+			listingCodeStart += delta;
+			listingCodeEnd += delta;
+		}
+	}
+
+	SetAsmOutputBuffer(output);
+	TextBufFree(&text);
+
+	return disasmResult;
+}
+
+
+/*************************************************************************** 
+	Change the hints of the module after DisasmPrepare. The module is
+	traced again from the decoded steps, and only the labels and lines
+	that the change reaches are redone. If listing holds the listing from
+	DisasmRenderListing its changed lines are generated again in place.
+	The old hints must stay loaded until this returns.
+***************************************************************************/
+int DisasmUpdateHints(const Hints *hints, TextBuf *listing)
+{
+	const HintSet *oldSet;
+	u_char *mem;
+	BOOL wasRecording;
+	int result;
+
+	mem = rofFile->objectCode;
+	oldSet = hintSet;
+	disasmResult = 0;
+	BudgetReset();
+
+	/* Nothing is passed to the sinks while the lines are worked out */
+	wasRecording = recording;
+	recording = FALSE;
+
+	memcpy(oldTrace, traceInfo, MAX_MEMORY);
+	memcpy(oldHint, hintInfo, MAX_MEMORY);
+	memcpy(oldCode, codeInfo, MAX_MEMORY);
+
+	disasmHints = hints;
+	if(0 != RetraceObjectCode(rofFile))
+	{
+		return -1;
+	}
+
+	/* Labels and lines are worked out silently as on the first pass */
+	disasmPass = 1;
+	SetAsmOutputMode(FALSE);
+
+	updateSpanCount = 0;
+	FindTraceChanges();
+	result = FindUpdateRegions(mem);
+
+	/* Take away the labels of the old lines and add the new ones */
+	if(0 == result)
+	{
+		memcpy(newTrace, traceInfo, MAX_MEMORY);
+		memcpy(newHint, hintInfo, MAX_MEMORY);
+		memcpy(traceInfo, oldTrace, MAX_MEMORY);
+		memcpy(hintInfo, oldHint, MAX_MEMORY);
+
+		changedLabelCount = 0;
+		trackLabels = TRUE;
+		result = CountRegionLabels(mem, -1);
+
+		memcpy(traceInfo, newTrace, MAX_MEMORY);
+		memcpy(hintInfo, newHint, MAX_MEMORY);
+
+		if(0 == result)
+		{
+			result = CountRegionLabels(mem, 1);
+		}
+		trackLabels = FALSE;
+	}
+
+	/* Lines of changed labels and their references are done as well */
+	if(0 == result)
+	{
+		FindLabelChanges(rofFile, oldSet);
+		result = FindUpdateRegions(mem);
+	}
+
+	if(0 == result)
+	{
+		result = IndexRegions(mem);
+	}
+
+	disasmPass = 2;
+	SetAsmOutputMode(TRUE);
+
+	if(0 == result && NULL != listing)
+	{
+		result = RenderRegions(listing);
+	}
+
+	recording = wasRecording;
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Send the lines of the second pass to a chain of sinks. The listing is
+	not generated unless SetAsmRecordListing is used to keep it. Pass NULL
+	to only generate the listing again.
+***************************************************************************/
+void SetRecordSink(RecordSink *sink)
+{
+	recordSink = sink;
+	SetAsmRecord(NULL != sink ? &asmRecord : NULL);
+}
+
+
+/*************************************************************************** 
+	Set the number of threads used to render large modules
+***************************************************************************/
+void SetRenderThreads(int count)
+{
+	renderThreads = count < 1 ? 1 : count > MAX_RENDER_THREADS ? MAX_RENDER_THREADS : count;
+}
+
+
+/*************************************************************************** 
+	Check if the code of the module can be rendered on several threads.
+	The lines have to be going to a buffer, and record sinks are left to
+	the serial pass since they collect state across lines.
+***************************************************************************/
+static BOOL CanRenderParallel(void)
+{
+	return renderThreads > 1
+		&& NULL == recordSink
+		&& NULL != GetAsmOutputBuffer()
+		&& maxPC >= PARALLEL_RENDER_SIZE ? TRUE : FALSE;
+}
+
+
+/*************************************************************************** 
+	Render one chunk of the code into its own buffer
+***************************************************************************/
+static void RenderChunk(void *param)
+{
+	RenderChunkInfo *chunk;
+
+	chunk = param;
+
+	BudgetReset();
+	disasmResult = 0;
+	SetAsmOutputMode(TRUE);
+	SetAsmOutputBuffer(&chunk->output);
+
+	chunk->result = DisasmRange(NULL, chunk->start, chunk->end);
+	if(0 != chunk->result)
+	{
+		strcpy(chunk->error, GetErrorText());
+	}
+
+	SetAsmOutputBuffer(NULL);
+}
+
+
+/*************************************************************************** 
+	Render a chunk on a thread of its own, collecting its stats apart
+***************************************************************************/
+static void RenderChunkThread(void *param)
+{
+	RenderChunkInfo *chunk;
+
+	chunk = param;
+
+	TimelineThreadName("render worker");
+	StatsAttach(&chunk->stats);
+	StatsEnter(PHASE_PASS2);
+	RenderChunk(chunk);
+	StatsLeave();
+	StatsAttach(NULL);
+}
+
+
+/*************************************************************************** 
+	Render the indexed lines of the code in chunks on several threads and
+	add them to the output in order. Chunks only start at instructions so
+	every run of data is rendered whole by one thread.
+***************************************************************************/
+static int DisasmCodeParallel(FILE *outFile)
+{
+	RenderChunkInfo chunks[MAX_RENDER_THREADS];
+	Thread *threads[MAX_RENDER_THREADS];
+	TextBuf *output;
+	u_int32 line;
+	int count;
+	int i;
+
+	count = 0;
+	line = 0;
+	while(line < lineCount && count < renderThreads)
+	{
+		u_int32 next;
+
+		next = lineCount * (count + 1) / renderThreads;
+		while(next < lineCount && TRACE_DATA == GET_TRACEINFO(lineStart[next]))
+		{
+			next++;
+		}
+
+		chunks[count].start = lineStart[line];
+		chunks[count].end = next < lineCount ? lineStart[next] : maxPC;
+		chunks[count].result = 0;
+		chunks[count].error[0] = 0;
+		TextBufInit(&chunks[count].output);
+		memset(&chunks[count].stats, 0, sizeof(chunks[count].stats));
+		count++;
+
+		line = next;
+	}
+
+	output = GetAsmOutputBuffer();
+
+	/* The calling thread renders the first chunk */
+	for(i = 1; i < count; i++)
+	{
+		threads[i] = ThreadStart(RenderChunkThread, &chunks[i]);
+	}
+
+	RenderChunk(&chunks[0]);
+
+	for(i = 1; i < count; i++)
+	{
+		if(NULL != threads[i])
+		{
+			ThreadJoin(threads[i]);
+			StatsMerge(&chunks[i].stats);
+		}
+		else
+		{
+			RenderChunk(&chunks[i]);
+		}
+	}
+
+	SetAsmOutputBuffer(output);
+
+	for(i = 0; i < count; i++)
+	{
+		if(0 == disasmResult && 0 != chunks[i].result)
+		{
+			SetError("%s", chunks[i].error);
+			disasmResult = -1;
+		}
+
+		if(0 == disasmResult)
+		{
+			GenAsmWrite(outFile, chunks[i].output.text, chunks[i].output.length);
+		}
+
+		TextBufFree(&chunks[i].output);
+	}
+
+	return disasmResult;
+}
+
+
+/*************************************************************************** 
+	Generate the listing of a module once its code has been marked
+***************************************************************************/
+static int DisasmListing(FILE *outFile, OS9ROF *rfile)
+{
+	StatsEnter(PHASE_PASS2);
+
+	/* Set to the second pass */
+	DisasmSetPass(outFile, 2);
+
+	DisasmPreamble(outFile, rfile);
+
+	/* Disassemble the file */
+	if(TRUE == parallelRender)
+	{
+		DisasmCodeParallel(outFile);
+	}
+	else
+	{
+		while(0 == DisasmDecode(outFile, rfile->objectCode));
+	}
+
+	if(0 == disasmResult)
+	{
+		/* Output the end of the assembler file */
+		GenAsm(outFile, "*\n\tendsect\n");
+
+		if(TRUE == recording)
+		{
+			SinkEnd(outFile);
+		}
+
+		if(NULL != outFile && ferror(outFile))
+		{
+			SetError("error writing output");
+			disasmResult = -1;
+		}
+	}
+
+	StatsLeave();
+
+	return 0 != disasmResult ? -1 : 0;
+}
+
+
+/*************************************************************************** 
+
+***************************************************************************/
+int DisasmObjectCode(FILE *outFile, OS9ROF *rfile)
+{
+	int result;
+
+	if(0 != DisasmFirstPass(outFile, rfile))
+	{
+		return -1;
+	}
+
+	/* Large modules are indexed so their lines can be split up */
+	parallelRender = CanRenderParallel();
+	if(TRUE == parallelRender && 0 != DisasmIndexLines(outFile, rfile))
+	{
+		parallelRender = FALSE;
+		return -1;
+	}
+
+	result = DisasmListing(outFile, rfile);
+	parallelRender = FALSE;
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Generate the listing of a module marked by SweepObjectCode. The first
+	pass is skipped so only referenced locations get labels.
+***************************************************************************/
+int DisasmSweepCode(FILE *outFile, OS9ROF *rfile)
+{
+	if(0 != DisasmReset(outFile, rfile, rfile->sizeObjectCode))
+	{
+		return -1;
+	}
 
-	/* Output the end of the assembler file */
-	GenAsm(outFile, "*\n\tendsect\n");
+	return DisasmListing(outFile, rfile);
 }
 
 
@@ -11,6 +11,8 @@
 #define DISASM_H
 
 #include "rof.h"
+#include "genasm.h"
+#include "hints.h"
 
 #define MAX_MEMORY			65536
 
@@ -50,15 +52,46 @@
 #define MAX_OS9CALLS		0x91	/* Maximum number of OS-9 calls in the call table */
 
 
+typedef struct
+{
+	u_int16		address;	/* Offset of the line in the code */
+	u_int16		length;		/* Number of code bytes on the line */
+	BOOL		code;		/* TRUE for an instruction, FALSE for a run of data */
+} DisasmLineInfo;
+
+typedef struct
+{
+	u_int32		modules;			/* Modules swept */
+	u_int32		instructions;		/* Instructions decoded */
+	u_int32		bytes;				/* Code bytes decoded as instructions */
+	u_int32		trailing;			/* Code bytes cut off at the end of modules */
+	u_int32		opcodes[3][256];	/* Counts of page 0, $10, and $11 opcodes */
+} SweepStats;
+
+
+/* Flow class of an opcode, how the trace continues after it */
+typedef enum
+{
+	FLOW_NEXT,			/* Continues with the next instruction */
+	FLOW_INDEXED,		/* Continues, the postbyte can add bytes */
+	FLOW_BRANCH,		/* Traces the target of a short branch then continues */
+	FLOW_BRANCH_LONG,	/* Traces the target of a long branch then continues */
+	FLOW_JUMP,			/* Continues at the target of a short branch */
+	FLOW_JUMP_LONG,		/* Continues at the target of a long branch */
+	FLOW_RETURN,		/* Ends the trace */
+	FLOW_PULL,			/* Ends the trace if the pc is pulled */
+	FLOW_PAGE10,		/* Page $10 prefix */
+	FLOW_PAGE11			/* Page $11 prefix */
+} FLOW;
+
 typedef int (*DISASM)(FILE *outFile, u_char *mem, struct _Opcode *op, u_char code, u_int16 pc);
-typedef int (*TRACE)(u_char *mem, struct _Opcode *op, u_char code, u_int16 pc);
 
 typedef struct _Opcode
 {
 	char		*opName;	/* Name of the operation */
 	int			byteCount;	/* Number of bytes for the operation */
 	DISASM		disasmFunc;	/* Call for disassembler operation */
-	TRACE		traceFunc;	/* Call for trace operation */
+	FLOW		flow;		/* Flow class of the operation for the trace */
 	u_char		opValue;	/* Test value (unused) */
 } Opcode;
 
@@ -93,23 +126,20 @@ int	DisasmPage10(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 pc
 int	DisasmPage11(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 pc);
 int	DisasmOS9SysCall(FILE *outFile, u_char *mem, Opcode *op, u_char code, u_int16 pc);
 
-/* Code trace callback functions */
-int	TraceReturn(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TraceGeneric(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TracePage10(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TracePage11(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TraceIndexed(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TraceRelative(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TraceRelativeLong(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TracePage10(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TracePage11(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int	TracePullStack(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int TraceRelativeJump(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-int TraceRelativeJumpLong(u_char *mem, Opcode *op, u_char code, u_int16 pc);
-
 /* Trace and disassembler interface calls */
-void TraceObjectCode(OS9ROF *rfile);
-void DisasmObjectCode(FILE *outFile, OS9ROF *rfile);
+int TraceObjectCode(OS9ROF *rfile);
+void SetRenderThreads(int count);
+void SetDisasmHints(const Hints *hints);
+int DisasmObjectCode(FILE *outFile, OS9ROF *rfile);
+int SweepObjectCode(OS9ROF *rfile);
+int SweepStatistics(OS9ROF *rfile, SweepStats *stats);
+int DisasmSweepCode(FILE *outFile, OS9ROF *rfile);
+void SetRecordSink(RecordSink *sink);
+int DisasmPrepare(FILE *outFile, OS9ROF *rfile);
+int DisasmLine(FILE *outFile, u_int16 pc, DisasmLineInfo *line);
+int DisasmRange(FILE *outFile, u_int16 start, u_int16 end);
+int DisasmRenderListing(TextBuf *listing);
+int DisasmUpdateHints(const Hints *hints, TextBuf *listing);
 
 #endif	/* DISASM_H */
 
@@ -7,7 +7,9 @@
 	of this file.
 
 *****************************************************************************/
+#include <stdio.h>
 #include <stdarg.h>
+#include <ctype.h>
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,7 +18,22 @@
 
 
 
-static BOOL outputAsm = FALSE;
+typedef enum
+{
+	FIELD_NONE,			/* Text is not part of a record and is dropped */
+	FIELD_LABEL,		/* Text is the label of the line */
+	FIELD_OPERANDS,		/* Text is the operands of the instruction */
+	FIELD_COMMENT		/* Text is the comment at the end of the line */
+} FIELD;
+
+
+/* Each thread generates its own lines */
+static THREAD_LOCAL BOOL outputAsm = FALSE;
+static THREAD_LOCAL TextBuf *outputBuffer = NULL;
+static THREAD_LOCAL AsmRecord *record = NULL;		/* Record capturing the output */
+static THREAD_LOCAL FIELD recordField = FIELD_NONE;	/* Field the output is captured in */
+static THREAD_LOCAL BOOL recordRef = FALSE;			/* Next text is the reference label */
+static THREAD_LOCAL BOOL recordListing = FALSE;		/* Captured text is also written */
 
 
 /*************************************************************************** 
@@ -26,13 +43,207 @@ void SetAsmOutputMode(BOOL mode)
 	outputAsm = mode;
 }
 
+/*
+	When an output buffer is set all generated text is captured in it
+	and the file passed to the generators is ignored.
+*/
+void SetAsmOutputBuffer(TextBuf *buffer)
+{
+	outputBuffer = buffer;
+}
+
+TextBuf *GetAsmOutputBuffer(void)
+{
+	return outputBuffer;
+}
+
+static int AsmVWrite(FILE *outFile, const char *fmt, va_list list)
+{
+	if(NULL != outputBuffer)
+	{
+		return TextBufVPrintf(outputBuffer, fmt, list);
+	}
+
+	return vfprintf(outFile, fmt, list);
+}
+
+
+static void AppendField(char *field, size_t size, const char *text)
+{
+	size_t length;
+	size_t count;
+
+	length = strlen(field);
+	count = strlen(text);
+	if(count > size - length - 1)
+	{
+		count = size - length - 1;
+	}
+
+	memcpy(field + length, text, count);
+	field[length + count] = 0;
+}
+
+
+/*************************************************************************** 
+	Add generated text to the field of the record being captured
+***************************************************************************/
+static void CaptureText(const char *text)
+{
+	switch(recordField)
+	{
+	case FIELD_LABEL:
+		AppendField(record->label, sizeof(record->label), text);
+		break;
+
+	case FIELD_OPERANDS:
+		AppendField(record->operands, sizeof(record->operands), text);
+		if(TRUE == recordRef)
+		{
+			AppendField(record->refLabel, sizeof(record->refLabel), text);
+			recordRef = FALSE;
+		}
+		break;
+
+	case FIELD_COMMENT:
+		AppendField(record->comment, sizeof(record->comment), text);
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+static int AsmVPrintf(FILE *outFile, const char *fmt, va_list list)
+{
+	char text[256];
+	int length;
+
+	if(NULL == record)
+	{
+		return AsmVWrite(outFile, fmt, list);
+	}
+
+	if(TRUE == recordListing)
+	{
+		va_list copy;
+
+		va_copy(copy, list);
+		AsmVWrite(outFile, fmt, copy);
+		va_end(copy);
+	}
+
+	length = vsnprintf(text, sizeof(text), fmt, list);
+	CaptureText(text);
+
+	return length;
+}
+
+
+/*************************************************************************** 
+	Capture generated lines in a record instead of writing them. Only the
+	text between BeginAsmRecord and EndAsmRecord is kept.
+***************************************************************************/
+void SetAsmRecord(AsmRecord *newRecord)
+{
+	record = newRecord;
+	recordField = FIELD_NONE;
+	recordRef = FALSE;
+}
+
+
+AsmRecord *GetAsmRecord(void)
+{
+	return record;
+}
+
+
+/*
+	Keep generating the listing while lines are captured so one pass
+	produces both.
+*/
+void SetAsmRecordListing(BOOL listing)
+{
+	recordListing = listing;
+}
+
+
+void BeginAsmRecord(u_int16 address)
+{
+	memset(record, 0, sizeof(AsmRecord));
+	record->address = address;
+	recordField = FIELD_LABEL;
+	recordRef = FALSE;
+}
+
+
+static void TrimField(char *field, const char *strip)
+{
+	char *start;
+	char *end;
+
+	start = field;
+	while(0 != *start && (isspace((u_char)*start) || NULL != strchr(strip, *start)))
+	{
+		start++;
+	}
+
+	end = start + strlen(start);
+	while(end > start && (isspace((u_char)end[-1]) || NULL != strchr(strip, end[-1])))
+	{
+		end--;
+	}
+
+	memmove(field, start, end - start);
+	field[end - start] = 0;
+}
+
+
+void EndAsmRecord(void)
+{
+	TrimField(record->label, ":");
+	TrimField(record->operands, "");
+	TrimField(record->comment, "*");
+	recordField = FIELD_NONE;
+	recordRef = FALSE;
+}
+
 void GenAsmTabs(FILE *outFile, int lsize)
 {
-	while(lsize < MAX_TABS)
+	static const char tabs[] = "\t\t\t\t\t\t\t\t";
+	int count;
+
+	count = 0;
+	while(lsize < MAX_TABS && count < (int)sizeof(tabs) - 1)
 	{
-		GenAsm(outFile, "\t");
+		count++;
 		lsize += TAB_SIZE;
 	}
+
+	if(0 != count)
+	{
+		GenAsmWrite(outFile, tabs, count);
+	}
+}
+
+
+/*************************************************************************** 
+	Generate the address that starts a line in the listing
+***************************************************************************/
+void GenAsmAddressPrefix(FILE *outFile, u_int16 address)
+{
+	static const char hexDigits[] = "0123456789ABCDEF";
+	char text[6];
+
+	text[0] = hexDigits[(address >> 12) & 0x0f];
+	text[1] = hexDigits[(address >> 8) & 0x0f];
+	text[2] = hexDigits[(address >> 4) & 0x0f];
+	text[3] = hexDigits[address & 0x0f];
+	text[4] = ':';
+	text[5] = '\t';
+
+	GenAsmWrite(outFile, text, sizeof(text));
 }
 
 /*************************************************************************** 
@@ -68,6 +279,22 @@ char *GetReferenceLabel(OS9ROF *rfile, u_int16 label)
 }
 
 
+/*************************************************************************** 
+	Generate text regardless of the output mode
+***************************************************************************/
+int GenText(FILE *outFile, const char *fmt, ...)
+{
+	va_list list;
+	int size;
+
+	va_start(list, fmt);
+	size = AsmVPrintf(outFile, fmt, list);
+	va_end(list);
+
+	return size;
+}
+
+
 /*************************************************************************** 
 
 ***************************************************************************/
@@ -79,7 +306,7 @@ int GenAsm(FILE *outFile, const char *fmt, ...)
 		int size;
 
 		va_start(list, fmt);
-		size = vfprintf(outFile, fmt, list);
+		size = AsmVPrintf(outFile, fmt, list);
 		va_end(list);
 
 		return size;
@@ -88,6 +315,45 @@ int GenAsm(FILE *outFile, const char *fmt, ...)
 }
 
 
+/*************************************************************************** 
+	Generate text that is already formatted. Data lines are built in
+	place and written with one call instead of a formatted write for
+	every byte.
+***************************************************************************/
+int GenAsmWrite(FILE *outFile, const char *text, u_int32 length)
+{
+	if(FALSE == outputAsm)
+	{
+		return 0;
+	}
+
+	if(NULL == record || TRUE == recordListing)
+	{
+		if(NULL != outputBuffer)
+		{
+			TextBufWrite(outputBuffer, text, length);
+		}
+		else
+		{
+			fwrite(text, 1, length, outFile);
+		}
+	}
+
+	if(NULL != record)
+	{
+		char field[256];
+		u_int32 count;
+
+		count = length < sizeof(field) ? length : sizeof(field) - 1;
+		memcpy(field, text, count);
+		field[count] = 0;
+		CaptureText(field);
+	}
+
+	return (int)length;
+}
+
+
 /*************************************************************************** 
 ***************************************************************************/
 int GenAsmOp(FILE *outFile, const char *op, const char *fmt, ...)
@@ -101,16 +367,28 @@ int GenAsmOp(FILE *outFile, const char *op, const char *fmt, ...)
 			op = "????";
 		}
 
+		/* The mnemonic and the tabs after it are not part of any field */
+		if(NULL != record)
+		{
+			strncpy(record->mnemonic, op, sizeof(record->mnemonic) - 1);
+			recordField = FIELD_NONE;
+		}
+
 		length += GenAsm(outFile, "%s", op);
 
 		GenAsmTabs(outFile, length);
 
+		if(NULL != record)
+		{
+			recordField = FIELD_OPERANDS;
+		}
+
 		if(NULL != fmt)
 		{
 			va_list list;
 
 			va_start(list, fmt);
-			length += vfprintf(outFile, fmt, list);
+			length += AsmVPrintf(outFile, fmt, list);
 			va_end(list);
 		}
 	}
@@ -119,6 +397,73 @@ int GenAsmOp(FILE *outFile, const char *op, const char *fmt, ...)
 }
 
 
+/*************************************************************************** 
+	Generate the comment at the end of a line
+***************************************************************************/
+int GenAsmComment(FILE *outFile, const char *fmt, ...)
+{
+	if(TRUE == outputAsm)
+	{
+		va_list list;
+		int size;
+
+		if(NULL != record)
+		{
+			recordField = FIELD_COMMENT;
+		}
+
+		va_start(list, fmt);
+		size = AsmVPrintf(outFile, fmt, list);
+		va_end(list);
+
+		return size;
+	}
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Note the kind of reference the operand being generated resolves to.
+	The next text generated is the label for the reference.
+***************************************************************************/
+void GenAsmReference(ASMREF kind, u_int16 target)
+{
+	if(TRUE == outputAsm && NULL != record && FIELD_OPERANDS == recordField)
+	{
+		record->refKind = kind;
+		record->refTarget = target;
+		recordRef = TRUE;
+	}
+}
+
+
+/*************************************************************************** 
+	Generate text that is never captured in a record
+***************************************************************************/
+int GenRaw(FILE *outFile, const char *fmt, ...)
+{
+	va_list list;
+	int size;
+
+	va_start(list, fmt);
+	size = AsmVWrite(outFile, fmt, list);
+	va_end(list);
+
+	return size;
+}
+
+
+int GenRawBytes(FILE *outFile, const void *data, u_int32 length)
+{
+	if(NULL != outputBuffer)
+	{
+		return TextBufWrite(outputBuffer, data, length);
+	}
+
+	return (int)fwrite(data, 1, length, outFile);
+}
+
+
 /*************************************************************************** 
 ***************************************************************************/
 int GenAsmLabelCode(FILE *outFile, u_int16 label)
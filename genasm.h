@@ -12,20 +12,86 @@
 
 #include "util.h"
 #include "rof.h"
+#include "textbuf.h"
 
 #define MAX_TABS	12
 #define TAB_SIZE	4
 
+typedef enum
+{
+	ASMREF_NONE,		/* Operand does not reference anything */
+	ASMREF_CODE,		/* Operand references a location in the code */
+	ASMREF_DATA,		/* Operand references initialized data */
+	ASMREF_BSS,			/* Operand references uninitialized data */
+	ASMREF_EXTERNAL,	/* Operand references an external symbol */
+	ASMREF_ABSOLUTE		/* Operand is an address outside of the module */
+} ASMREF;
+
+#define SECTION_CODE	0		/* Record is in the code */
+#define SECTION_DATA	1		/* Record is in the initialized data */
+
+/*
+	Fields of a generated line captured for structured output. While a
+	record is set, generated text is split into these fields instead of
+	being written.
+*/
+typedef struct
+{
+	u_int16		address;			/* Address of the line */
+	u_int16		length;				/* Number of bytes on the line */
+	char		label[SYMLEN + 2];	/* Label defined on the line */
+	char		mnemonic[16];		/* Instruction mnemonic */
+	char		operands[128];		/* Operand text */
+	char		comment[128];		/* Trailing comment */
+	ASMREF		refKind;			/* Kind of reference in the operand */
+	u_int16		refTarget;			/* Address the reference resolves to */
+	char		refLabel[SYMLEN + 2];	/* Label generated for the reference */
+} AsmRecord;
+
+/*
+	Receives the structured output of the second disassembly pass. The
+	module call starts a module and end finishes it. Sinks generate their
+	output with GenRaw and GenRawBytes, which write to the sink's output
+	buffer when it has one. Sinks are chained through next so one pass
+	can feed several of them.
+*/
+typedef struct _RecordSink RecordSink;
+
+struct _RecordSink
+{
+	void		(*module)(RecordSink *sink, FILE *outFile, OS9ROF *rfile);
+	void		(*instruction)(RecordSink *sink, FILE *outFile, const AsmRecord *record, const u_char *bytes);
+	void		(*data)(RecordSink *sink, FILE *outFile, int section, const u_char *bytes, u_int16 address, u_int16 length);
+	void		(*end)(RecordSink *sink, FILE *outFile);
+	void		*context;		/* Sink specific state */
+	TextBuf		*output;		/* Destination of the sink, NULL for the listing destination */
+	RecordSink	*next;			/* Next sink fed by the same pass */
+};
+
 void SetAsmOutputMode(BOOL mode);
+void SetAsmOutputBuffer(TextBuf *buffer);
+TextBuf *GetAsmOutputBuffer(void);
+void SetAsmRecord(AsmRecord *record);
+AsmRecord *GetAsmRecord(void);
+void SetAsmRecordListing(BOOL listing);
+void BeginAsmRecord(u_int16 address);
+void EndAsmRecord(void);
 
 char *GetReferenceLabel(OS9ROF *rfile, u_int16 label);
 
+int GenText(FILE *outFile, const char *fmt, ...);
 int GenAsm(FILE *outFile, const char *fmt, ...);
+int GenAsmWrite(FILE *outFile, const char *text, u_int32 length);
 int GenAsmOp(FILE *outFile, const char *op, const char *fmt, ...);
+int GenAsmComment(FILE *outFile, const char *fmt, ...);
+void GenAsmReference(ASMREF kind, u_int16 target);
+int GenRaw(FILE *outFile, const char *fmt, ...);
+int GenRawBytes(FILE *outFile, const void *data, u_int32 length);
 
 typedef int (*GENLABEL)(FILE *outFile, u_int16 location);
 
 void GenAsmTabs(FILE *outFile, int lsize);
+void GenAsmAddressPrefix(FILE *outFile, u_int16 address);
 void GenAsmAddress(FILE *outFile, u_int16 address);
 int GenAsmLabelCode(FILE *outFile, u_int16 label);
 int GenAsmLabelCodeData(FILE *outFile, u_int16 label);
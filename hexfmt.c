@@ -0,0 +1,371 @@
+/*****************************************************************************
+	hexfmt.c	- Conversion of byte runs to hex text
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Data sections are most of the output so the bytes are converted with
+	SSE2 or AVX2 when the processor has them. The kernel is picked by
+	HexInit() at startup and the scalar version is used everywhere else. Every kernel produces the same text.
+
+*****************************************************************************/
+#include <string.h>
+#include "hexfmt.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define HEX_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_SSE2
+#define TARGET_AVX2
+#else
+#define TARGET_SSE2		__attribute__((target("sse2")))
+#define TARGET_AVX2		__attribute__((target("avx2")))
+#endif
+#include <immintrin.h>
+#endif
+
+#define LOWER_ADJUST	('a' - '0' - 10)	/* Added to nibbles above 9 for a-f */
+#define UPPER_ADJUST	('A' - '0' - 10)	/* Added to nibbles above 9 for A-F */
+
+typedef struct
+{
+	const char	*name;
+	/* Writes count * HEX_FCB_WIDTH characters, the last one a comma */
+	void		(*fcb)(char *text, const u_char *bytes, u_int32 count);
+	/* Writes count * 2 upper case hex digits */
+	void		(*pairs)(char *text, const u_char *bytes, u_int32 count);
+} HexKernel;
+
+
+static const char lowerDigits[] = "0123456789abcdef";
+static const char upperDigits[] = "0123456789ABCDEF";
+
+
+/*************************************************************************** 
+	Scalar kernel, also used for the bytes left over by the others
+***************************************************************************/
+static void ScalarFcb(char *text, const u_char *bytes, u_int32 count)
+{
+	while(count--)
+	{
+		text[0] = '$';
+		text[1] = lowerDigits[*bytes >> 4];
+		text[2] = lowerDigits[*bytes & 0x0f];
+		text[3] = ',';
+		text += HEX_FCB_WIDTH;
+		bytes++;
+	}
+}
+
+
+static void ScalarPairs(char *text, const u_char *bytes, u_int32 count)
+{
+	while(count--)
+	{
+		text[0] = upperDigits[*bytes >> 4];
+		text[1] = upperDigits[*bytes & 0x0f];
+		text += 2;
+		bytes++;
+	}
+}
+
+
+static const HexKernel scalarKernel = {"scalar", ScalarFcb, ScalarPairs};
+
+
+#ifdef HEX_X86
+
+/*************************************************************************** 
+	SSE2 kernel - 8 bytes at a time
+***************************************************************************/
+TARGET_SSE2 static __m128i Sse2Digits(__m128i nibbles, char adjust)
+{
+	__m128i above;
+
+	above = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+	nibbles = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+
+	return _mm_add_epi8(nibbles, _mm_and_si128(above, _mm_set1_epi8(adjust)));
+}
+
+
+TARGET_SSE2 static void Sse2Fcb(char *text, const u_char *bytes, u_int32 count)
+{
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	const __m128i dollar = _mm_set1_epi8('$');
+	const __m128i comma = _mm_set1_epi8(',');
+
+	while(count >= 8)
+	{
+		__m128i value;
+		__m128i high;
+		__m128i low;
+		__m128i left;
+		__m128i right;
+
+		value = _mm_loadl_epi64((const __m128i *)bytes);
+		high = Sse2Digits(_mm_and_si128(_mm_srli_epi16(value, 4), mask), LOWER_ADJUST);
+		low = Sse2Digits(_mm_and_si128(value, mask), LOWER_ADJUST);
+
+		/* '$' high and low ',' interleaved into four characters per byte */
+		left = _mm_unpacklo_epi8(dollar, high);
+		right = _mm_unpacklo_epi8(low, comma);
+		_mm_storeu_si128((__m128i *)text, _mm_unpacklo_epi16(left, right));
+		_mm_storeu_si128((__m128i *)(text + 16), _mm_unpackhi_epi16(left, right));
+
+		text += 8 * HEX_FCB_WIDTH;
+		bytes += 8;
+		count -= 8;
+	}
+
+	ScalarFcb(text, bytes, count);
+}
+
+
+TARGET_SSE2 static void Sse2Pairs(char *text, const u_char *bytes, u_int32 count)
+{
+	const __m128i mask = _mm_set1_epi8(0x0f);
+
+	while(count >= 8)
+	{
+		__m128i value;
+		__m128i high;
+		__m128i low;
+
+		value = _mm_loadl_epi64((const __m128i *)bytes);
+		high = Sse2Digits(_mm_and_si128(_mm_srli_epi16(value, 4), mask), UPPER_ADJUST);
+		low = Sse2Digits(_mm_and_si128(value, mask), UPPER_ADJUST);
+		_mm_storeu_si128((__m128i *)text, _mm_unpacklo_epi8(high, low));
+
+		text += 16;
+		bytes += 8;
+		count -= 8;
+	}
+
+	ScalarPairs(text, bytes, count);
+}
+
+
+static const HexKernel sse2Kernel = {"sse2", Sse2Fcb, Sse2Pairs};
+
+
+/*************************************************************************** 
+	AVX2 kernel - each byte is widened to the characters it becomes
+***************************************************************************/
+TARGET_AVX2 static __m256i Avx2Digits(__m256i nibbles, int adjust)
+{
+	__m256i above;
+
+	above = _mm256_cmpgt_epi32(nibbles, _mm256_set1_epi32(9));
+	nibbles = _mm256_add_epi32(nibbles, _mm256_set1_epi32('0'));
+
+	return _mm256_add_epi32(nibbles, _mm256_and_si256(above, _mm256_set1_epi32(adjust)));
+}
+
+
+TARGET_AVX2 static void Avx2Fcb(char *text, const u_char *bytes, u_int32 count)
+{
+	const __m256i mask = _mm256_set1_epi32(0x0f);
+	const __m256i frame = _mm256_set1_epi32('$' | (',' << 24));
+
+	while(count >= 8)
+	{
+		__m256i value;
+		__m256i high;
+		__m256i low;
+
+		value = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)bytes));
+		high = Avx2Digits(_mm256_and_si256(_mm256_srli_epi32(value, 4), mask), LOWER_ADJUST);
+		low = Avx2Digits(_mm256_and_si256(value, mask), LOWER_ADJUST);
+
+		value = _mm256_or_si256(frame, _mm256_or_si256(_mm256_slli_epi32(high, 8), _mm256_slli_epi32(low, 16)));
+		_mm256_storeu_si256((__m256i *)text, value);
+
+		text += 8 * HEX_FCB_WIDTH;
+		bytes += 8;
+		count -= 8;
+	}
+
+	ScalarFcb(text, bytes, count);
+}
+
+
+TARGET_AVX2 static void Avx2Pairs(char *text, const u_char *bytes, u_int32 count)
+{
+	const __m256i mask = _mm256_set1_epi16(0x0f);
+
+	while(count >= 16)
+	{
+		__m256i value;
+		__m256i high;
+		__m256i low;
+		__m256i above;
+
+		/* Each byte widened to the two digits it becomes */
+		value = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)bytes));
+		high = _mm256_and_si256(_mm256_srli_epi16(value, 4), mask);
+		low = _mm256_and_si256(value, mask);
+		value = _mm256_or_si256(high, _mm256_slli_epi16(low, 8));
+
+		above = _mm256_cmpgt_epi8(value, _mm256_set1_epi8(9));
+		value = _mm256_add_epi8(value, _mm256_set1_epi8('0'));
+		value = _mm256_add_epi8(value, _mm256_and_si256(above, _mm256_set1_epi8(UPPER_ADJUST)));
+		_mm256_storeu_si256((__m256i *)text, value);
+
+		text += 32;
+		bytes += 16;
+		count -= 16;
+	}
+
+	Sse2Pairs(text, bytes, count);
+}
+
+
+static const HexKernel avx2Kernel = {"avx2", Avx2Fcb, Avx2Pairs};
+
+
+/*************************************************************************** 
+	Check which of the instruction sets the processor and system support
+***************************************************************************/
+static BOOL HasSse2(void)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	return TRUE;
+#elif defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 1);
+	return 0 != (info[3] & (1 << 26)) ? TRUE : FALSE;
+#else
+	return __builtin_cpu_supports("sse2") ? TRUE : FALSE;
+#endif
+}
+
+
+static BOOL HasAvx2(void)
+{
+#ifdef _MSC_VER
+	int info[4];
+
+	/* The system has to save the AVX registers as well */
+	__cpuid(info, 1);
+	if(0 == (info[2] & (1 << 27)) || 0 == (info[2] & (1 << 28)) || 6 != (_xgetbv(0) & 6))
+	{
+		return FALSE;
+	}
+
+	__cpuidex(info, 7, 0);
+	return 0 != (info[1] & (1 << 5)) ? TRUE : FALSE;
+#else
+	return __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+#endif
+}
+
+#endif	/* HEX_X86 */
+
+
+/*************************************************************************** 
+	Pick the kernel for this processor. The kernel is shared by the render
+	threads so it is selected once at startup before any of them run, and
+	the scalar kernel is used until then.
+***************************************************************************/
+static const HexKernel *kernel = &scalarKernel;
+
+void HexInit(void)
+{
+#ifdef HEX_X86
+	if(TRUE == HasAvx2())
+	{
+		kernel = &avx2Kernel;
+	}
+	else if(TRUE == HasSse2())
+	{
+		kernel = &sse2Kernel;
+	}
+#endif
+}
+
+
+/*************************************************************************** 
+	Convert a run of bytes to hex text and return the length of the text.
+	text must have room for count * HEX_FCB_WIDTH or HEX_DUMP_WIDTH
+	characters. It is not null terminated.
+***************************************************************************/
+u_int32 HexFormat(char *text, const u_char *bytes, u_int32 count, HEXSTYLE style)
+{
+	char pairs[64];
+	u_int32 done;
+	u_int32 index;
+
+	if(0 == count)
+	{
+		return 0;
+	}
+
+	if(HEX_FCB == style)
+	{
+		kernel->fcb(text, bytes, count);
+
+		/* No comma after the last byte */
+		return count * HEX_FCB_WIDTH - 1;
+	}
+
+	/* Spaces are added while the digits are still in the cache */
+	for(done = 0; done < count; done += index)
+	{
+		u_int32 chunk;
+
+		chunk = count - done < sizeof(pairs) / 2 ? count - done : sizeof(pairs) / 2;
+		kernel->pairs(pairs, bytes + done, chunk);
+
+		for(index = 0; index < chunk; index++)
+		{
+			text[0] = pairs[index * 2];
+			text[1] = pairs[index * 2 + 1];
+			text[2] = ' ';
+			text += HEX_DUMP_WIDTH;
+		}
+	}
+
+	return count * HEX_DUMP_WIDTH;
+}
+
+
+const char *HexKernelName(void)
+{
+	return kernel->name;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,57 @@
+/*****************************************************************************
+	hexfmt.h	- Conversion of byte runs to hex text
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#ifndef HEXFMT_H
+#define HEXFMT_H
+
+#include "util.h"
+
+typedef enum
+{
+	HEX_FCB,			/* $xx,$xx,$xx - operands of an fcb line */
+	HEX_DUMP			/* XX XX XX  - hex dump, each byte followed by a space */
+} HEXSTYLE;
+
+#define HEX_FCB_WIDTH	4		/* Characters needed per byte for HEX_FCB */
+#define HEX_DUMP_WIDTH	3		/* Characters needed per byte for HEX_DUMP */
+
+void HexInit(void);
+u_int32 HexFormat(char *text, const u_char *bytes, u_int32 count, HEXSTYLE style);
+const char *HexKernelName(void);
+
+#endif	/* HEXFMT_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,554 @@
+/*****************************************************************************
+	hints.c	- Memory description (hints) files
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	A hints file describes what is known about the code of modules. Each
+	line holds one hint and everything after a # is ignored. Addresses
+	are offsets in the code written in hex with an optional $ or 0x, and
+	ranges include their end address.
+
+		module <name>			following hints are for the named module
+		code <start> [<end>]	instructions, traced from every one in the range
+		data <start> <end>		data that is never traced
+		string <start> <end>	text that is never traced
+		words <start> <end>		table of words
+		jumptable <start> <end>	table of code addresses, each one is traced
+		entry <address> [<name>]	start a trace here
+		label <address> <name>	name the label at the address
+
+	Hints before the first module line are used for modules that have no
+	hints of their own. The trace stops at an instruction that would run
+	into a data, string, words or jumptable range, and leaves its bytes
+	as data so the range is kept whole.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rof.h"
+#include "hints.h"
+
+typedef struct
+{
+	const char	*keyword;	/* Keyword starting the line */
+	HINTKIND	kind;		/* Kind of range it describes */
+} HintKeyword;
+
+static const HintKeyword rangeKeywords[] =
+{
+	{"code",		HINT_CODE},
+	{"data",		HINT_DATA},
+	{"string",		HINT_STRING},
+	{"words",		HINT_WORDS},
+	{"jumptable",	HINT_JUMPTABLE},
+	{NULL,			HINT_NONE}
+};
+
+
+
+/*************************************************************************** 
+	Parse an address in hex
+***************************************************************************/
+static BOOL ParseAddress(const char *text, u_int16 *address)
+{
+	unsigned long value;
+	char *end;
+
+	if('$' == *text)
+	{
+		text++;
+	}
+	else if('0' == text[0] && ('x' == text[1] || 'X' == text[1]))
+	{
+		text += 2;
+	}
+
+	if(0 == *text)
+	{
+		return FALSE;
+	}
+
+	value = strtoul(text, &end, 16);
+	if(0 != *end || value > 0xffff)
+	{
+		return FALSE;
+	}
+
+	*address = (u_int16)value;
+
+	return TRUE;
+}
+
+
+/*************************************************************************** 
+	Copy a string to the heap
+***************************************************************************/
+static char *CopyString(const char *text)
+{
+	char *copy;
+
+	copy = MemAlloc(MEM_OTHER, (u_int32)strlen(text) + 1);
+	if(NULL != copy)
+	{
+		strcpy(copy, text);
+	}
+
+	return copy;
+}
+
+
+static int CompareRanges(const void *a, const void *b)
+{
+	const HintRange *left;
+	const HintRange *right;
+
+	left = a;
+	right = b;
+
+	return (int)left->start - (int)right->start;
+}
+
+
+static int CompareLabels(const void *a, const void *b)
+{
+	const HintLabel *left;
+	const HintLabel *right;
+
+	left = a;
+	right = b;
+
+	return (int)left->address - (int)right->address;
+}
+
+
+/*************************************************************************** 
+	Parse one line of a hints file into the current set
+***************************************************************************/
+static int ParseHint(Hints *hints, char *line)
+{
+	HintSet *set;
+	char keyword[32];
+	char first[256];
+	char second[256];
+	char *comment;
+	int fields;
+	int i;
+
+	comment = strchr(line, '#');
+	if(NULL != comment)
+	{
+		*comment = 0;
+	}
+
+	fields = sscanf(line, "%31s %255s %255s", keyword, first, second);
+	if(fields <= 0)
+	{
+		return 0;
+	}
+
+	set = &hints->sets[hints->setCount - 1];
+
+	if(0 == strcmp(keyword, "module"))
+	{
+		HintSet *sets;
+
+		if(fields < 2)
+		{
+			SetError("module name missing");
+			return -1;
+		}
+
+		sets = MemRealloc(MEM_OTHER, hints->sets, (hints->setCount + 1) * sizeof(HintSet));
+		if(NULL == sets)
+		{
+			SetError("out of memory");
+			return -1;
+		}
+
+		hints->sets = sets;
+		set = &hints->sets[hints->setCount++];
+		memset(set, 0, sizeof(HintSet));
+		set->module = CopyString(first);
+		if(NULL == set->module)
+		{
+			SetError("out of memory");
+			return -1;
+		}
+
+		return 0;
+	}
+
+	if(0 == strcmp(keyword, "entry") || 0 == strcmp(keyword, "label"))
+	{
+		HintLabel *labels;
+		HintLabel *label;
+		BOOL entry;
+
+		entry = 'e' == keyword[0] ? TRUE : FALSE;
+		if(fields < (TRUE == entry ? 2 : 3))
+		{
+			SetError("%s needs an address%s", keyword, TRUE == entry ? "" : " and a name");
+			return -1;
+		}
+
+		labels = MemRealloc(MEM_OTHER, set->labels, (set->labelCount + 1) * sizeof(HintLabel));
+		if(NULL == labels)
+		{
+			SetError("out of memory");
+			return -1;
+		}
+
+		set->labels = labels;
+		label = &set->labels[set->labelCount++];
+		label->entry = entry;
+		label->name = NULL;
+
+		if(FALSE == ParseAddress(first, &label->address))
+		{
+			SetError("bad address '%.40s'", first);
+			return -1;
+		}
+
+		if(fields > 2)
+		{
+			label->name = CopyString(second);
+			if(NULL == label->name)
+			{
+				SetError("out of memory");
+				return -1;
+			}
+		}
+
+		return 0;
+	}
+
+	for(i = 0; NULL != rangeKeywords[i].keyword; i++)
+	{
+		HintRange *ranges;
+		HintRange *range;
+
+		if(0 != strcmp(keyword, rangeKeywords[i].keyword))
+		{
+			continue;
+		}
+
+		/* Only code can be given by its start alone */
+		if(fields < (HINT_CODE == rangeKeywords[i].kind ? 2 : 3))
+		{
+			SetError("%s needs a start and an end address", keyword);
+			return -1;
+		}
+
+		ranges = MemRealloc(MEM_OTHER, set->ranges, (set->rangeCount + 1) * sizeof(HintRange));
+		if(NULL == ranges)
+		{
+			SetError("out of memory");
+			return -1;
+		}
+
+		set->ranges = ranges;
+		range = &set->ranges[set->rangeCount++];
+		range->kind = rangeKeywords[i].kind;
+
+		if(FALSE == ParseAddress(first, &range->start))
+		{
+			SetError("bad address '%.40s'", first);
+			return -1;
+		}
+
+		range->end = range->start;
+		if(fields > 2 && FALSE == ParseAddress(second, &range->end))
+		{
+			SetError("bad address '%.40s'", second);
+			return -1;
+		}
+
+		if(range->end < range->start)
+		{
+			SetError("range ends before it starts");
+			return -1;
+		}
+
+		return 0;
+	}
+
+	SetError("unknown hint '%s'", keyword);
+
+	return -1;
+}
+
+
+/*************************************************************************** 
+	Sort the hints of a set for searching and check that no two of them
+	describe the same address
+***************************************************************************/
+static int SortHintSet(HintSet *set)
+{
+	u_int32 i;
+
+	if(0 < set->rangeCount)
+	{
+		qsort(set->ranges, set->rangeCount, sizeof(HintRange), CompareRanges);
+	}
+
+	for(i = 1; i < set->rangeCount; i++)
+	{
+		if(set->ranges[i].start <= set->ranges[i - 1].end)
+		{
+			SetError("ranges at $%04X and $%04X overlap", set->ranges[i - 1].start, set->ranges[i].start);
+			return -1;
+		}
+	}
+
+	if(0 < set->labelCount)
+	{
+		qsort(set->labels, set->labelCount, sizeof(HintLabel), CompareLabels);
+	}
+
+	for(i = 1; i < set->labelCount; i++)
+	{
+		if(set->labels[i].address == set->labels[i - 1].address)
+		{
+			SetError("more than one label at $%04X", set->labels[i].address);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Load a hints file. Returns 0 on success, otherwise -1 with the reason
+	in the error text.
+***************************************************************************/
+int LoadHints(const char *filename, Hints **hints)
+{
+	Hints *loaded;
+	FILE *in;
+	char line[1024];
+	char reason[256];
+	int lineNumber;
+	u_int32 i;
+
+	*hints = NULL;
+
+	in = fopen(filename, "r");
+	if(NULL == in)
+	{
+		SetError("can't open hints file '%.200s'", filename);
+		return -1;
+	}
+
+	loaded = MemAlloc(MEM_OTHER, sizeof(Hints));
+	if(NULL != loaded)
+	{
+		loaded->sets = MemAlloc(MEM_OTHER, sizeof(HintSet));
+		loaded->setCount = 1;
+	}
+
+	if(NULL == loaded || NULL == loaded->sets)
+	{
+		fclose(in);
+		FreeHints(loaded);
+		SetError("out of memory");
+		return -1;
+	}
+
+	lineNumber = 0;
+	while(NULL != fgets(line, sizeof(line), in))
+	{
+		lineNumber++;
+		if(0 != ParseHint(loaded, line))
+		{
+			strncpy(reason, GetErrorText(), sizeof(reason) - 1);
+			reason[sizeof(reason) - 1] = 0;
+			SetError("%.80s(%d): %s", filename, lineNumber, reason);
+			fclose(in);
+			FreeHints(loaded);
+			return -1;
+		}
+	}
+
+	fclose(in);
+
+	for(i = 0; i < loaded->setCount; i++)
+	{
+		if(0 != SortHintSet(&loaded->sets[i]))
+		{
+			strncpy(reason, GetErrorText(), sizeof(reason) - 1);
+			reason[sizeof(reason) - 1] = 0;
+			SetError("%.80s: %.40s%s%s",
+				filename,
+				NULL != loaded->sets[i].module ? loaded->sets[i].module : "",
+				NULL != loaded->sets[i].module ? ": " : "",
+				reason);
+			FreeHints(loaded);
+			return -1;
+		}
+	}
+
+	*hints = loaded;
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+***************************************************************************/
+void FreeHints(Hints *hints)
+{
+	u_int32 i;
+	u_int32 j;
+
+	if(NULL == hints)
+	{
+		return;
+	}
+
+	for(i = 0; NULL != hints->sets && i < hints->setCount; i++)
+	{
+		HintSet *set;
+
+		set = &hints->sets[i];
+		for(j = 0; j < set->labelCount; j++)
+		{
+			MemFree(set->labels[j].name);
+		}
+
+		MemFree(set->labels);
+		MemFree(set->ranges);
+		MemFree(set->module);
+	}
+
+	MemFree(hints->sets);
+	MemFree(hints);
+}
+
+
+/*************************************************************************** 
+	Get the hints for a module, or the default set if it has none
+***************************************************************************/
+const HintSet *FindHintSet(const Hints *hints, const char *module)
+{
+	u_int32 i;
+
+	if(NULL == hints)
+	{
+		return NULL;
+	}
+
+	for(i = 1; i < hints->setCount; i++)
+	{
+		if(0 == strcmp(hints->sets[i].module, module))
+		{
+			return &hints->sets[i];
+		}
+	}
+
+	return &hints->sets[0];
+}
+
+
+/*************************************************************************** 
+	Find the range holding an address, NULL if there is none
+***************************************************************************/
+const HintRange *FindHintRange(const HintSet *set, u_int16 address)
+{
+	u_int32 low;
+	u_int32 high;
+
+	/* Find the first range starting after the address */
+	low = 0;
+	high = set->rangeCount;
+	while(low < high)
+	{
+		u_int32 mid;
+
+		mid = (low + high) / 2;
+		if(set->ranges[mid].start <= address)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	if(0 == low || address > set->ranges[low - 1].end)
+	{
+		return NULL;
+	}
+
+	return &set->ranges[low - 1];
+}
+
+
+/*************************************************************************** 
+	Find the label at an address, NULL if there is none
+***************************************************************************/
+const HintLabel *FindHintLabel(const HintSet *set, u_int16 address)
+{
+	u_int32 low;
+	u_int32 high;
+
+	low = 0;
+	high = set->labelCount;
+	while(low < high)
+	{
+		u_int32 mid;
+
+		mid = (low + high) / 2;
+		if(set->labels[mid].address == address)
+		{
+			return &set->labels[mid];
+		}
+
+		if(set->labels[mid].address < address)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return NULL;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
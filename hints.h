@@ -0,0 +1,89 @@
+/*****************************************************************************
+	hints.h	- Memory description (hints) files
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#ifndef HINTS_H
+#define HINTS_H
+
+#include "util.h"
+
+typedef enum
+{
+	HINT_NONE,			/* Nothing is known about the address */
+	HINT_CODE,			/* Instructions, traced from the start of the range */
+	HINT_DATA,			/* Data, never traced */
+	HINT_STRING,		/* Text, never traced */
+	HINT_WORDS,			/* Table of words, never traced */
+	HINT_JUMPTABLE		/* Table of code addresses that are traced */
+} HINTKIND;
+
+typedef struct
+{
+	u_int16		start;		/* First address of the range */
+	u_int16		end;		/* Last address of the range */
+	HINTKIND	kind;		/* What the range holds */
+} HintRange;
+
+typedef struct
+{
+	u_int16		address;	/* Address of the label */
+	BOOL		entry;		/* TRUE if the trace starts here */
+	char		*name;		/* Name of the label, NULL to generate one */
+} HintLabel;
+
+typedef struct
+{
+	char		*module;		/* Module the hints are for, NULL for the default set */
+	HintRange	*ranges;		/* Ranges sorted by address, never overlapping */
+	u_int32		rangeCount;
+	HintLabel	*labels;		/* Labels and entry points sorted by address */
+	u_int32		labelCount;
+} HintSet;
+
+typedef struct
+{
+	HintSet		*sets;			/* The default set first, then one per module */
+	u_int32		setCount;
+} Hints;
+
+int LoadHints(const char *filename, Hints **hints);
+void FreeHints(Hints *hints);
+const HintSet *FindHintSet(const Hints *hints, const char *module);
+const HintRange *FindHintRange(const HintSet *set, u_int16 address);
+const HintLabel *FindHintLabel(const HintSet *set, u_int16 address);
+
+#endif	/* HINTS_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
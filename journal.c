@@ -0,0 +1,312 @@
+/*****************************************************************************
+	journal.c	- Records completed modules so batch runs can be resumed
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Each completed module is appended to the journal as a single line:
+
+		<module offset> <input checksum> <output hash> <source file>
+
+	The line is flushed to disk before the next module is started. A line
+	torn by a crash fails to parse and is ignored so that module is
+	simply disassembled again.
+
+	The entries of a previous run are kept in a hash table on the source
+	file and offset so resuming a large batch doesn't search the whole
+	journal for every module.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#define fsync	_commit
+#else
+#include <unistd.h>
+#endif
+#include "journal.h"
+
+#define INITIAL_BUCKETS	1024	/* Buckets of the entry table, grows by doubling */
+
+typedef struct _JournalEntry
+{
+	struct _JournalEntry	*next;		/* Next entry in the bucket */
+	u_int32					key;		/* Hash of the source and offset */
+	u_int32					offset;		/* Offset of the module in the source file */
+	u_int32					checksum;	/* Checksum of the module input */
+	u_int32					outHash;	/* Hash of the generated output */
+	char					*source;	/* Name of the source file */
+} JournalEntry;
+
+static FILE *journal = NULL;
+static JournalEntry **buckets = NULL;
+static u_int32 bucketCount = 0;
+static u_int32 entryCount = 0;
+
+
+/*************************************************************************** 
+	Hash of the source file and offset of a module
+***************************************************************************/
+static u_int32 EntryKey(const char *source, u_int32 offset)
+{
+	u_int32 hash;
+	u_char bytes[4];
+
+	bytes[0] = (u_char)(offset >> 24);
+	bytes[1] = (u_char)(offset >> 16);
+	bytes[2] = (u_char)(offset >> 8);
+	bytes[3] = (u_char)offset;
+
+	hash = HashBytes(HASH_INIT, (const u_char *)source, (u_int32)strlen(source));
+	return HashBytes(hash, bytes, sizeof(bytes));
+}
+
+
+/*************************************************************************** 
+	Find the entry of a module, or NULL if there is none
+***************************************************************************/
+static JournalEntry *FindEntry(const char *source, u_int32 offset, u_int32 key)
+{
+	JournalEntry *entry;
+
+	if(0 == bucketCount)
+	{
+		return NULL;
+	}
+
+	for(entry = buckets[key & (bucketCount - 1)]; NULL != entry; entry = entry->next)
+	{
+		if(key == entry->key && offset == entry->offset && 0 == strcmp(source, entry->source))
+		{
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+
+/*************************************************************************** 
+	Double the buckets of the table, or create them
+***************************************************************************/
+static void GrowBuckets(void)
+{
+	JournalEntry **newBuckets;
+	u_int32 newCount;
+	u_int32 index;
+
+	newCount = 0 != bucketCount ? bucketCount * 2 : INITIAL_BUCKETS;
+	newBuckets = MemAlloc(MEM_OTHER, newCount * sizeof(JournalEntry *));
+	if(NULL == newBuckets)
+	{
+		return;
+	}
+
+	for(index = 0; index < bucketCount; index++)
+	{
+		JournalEntry *entry;
+
+		while(NULL != (entry = buckets[index]))
+		{
+			buckets[index] = entry->next;
+			entry->next = newBuckets[entry->key & (newCount - 1)];
+			newBuckets[entry->key & (newCount - 1)] = entry;
+		}
+	}
+
+	MemFree(buckets);
+	buckets = newBuckets;
+	bucketCount = newCount;
+}
+
+
+/*************************************************************************** 
+	Add the entry of a module. A later line for the same module replaces
+	the earlier one.
+***************************************************************************/
+static void AddEntry(const char *source, u_int32 offset, u_int32 checksum, u_int32 outHash)
+{
+	JournalEntry *entry;
+	u_int32 key;
+
+	key = EntryKey(source, offset);
+	entry = FindEntry(source, offset, key);
+	if(NULL == entry)
+	{
+		/* Keep about one entry a bucket, a table that can't grow gets longer chains */
+		if(entryCount >= bucketCount)
+		{
+			GrowBuckets();
+		}
+		if(0 == bucketCount)
+		{
+			return;
+		}
+
+		entry = MemAlloc(MEM_OTHER, sizeof(JournalEntry));
+		if(NULL == entry)
+		{
+			return;
+		}
+
+		entry->source = MemAlloc(MEM_OTHER, (u_int32)strlen(source) + 1);
+		if(NULL == entry->source)
+		{
+			MemFree(entry);
+			return;
+		}
+		strcpy(entry->source, source);
+
+		entry->key = key;
+		entry->offset = offset;
+		entry->next = buckets[key & (bucketCount - 1)];
+		buckets[key & (bucketCount - 1)] = entry;
+		entryCount++;
+	}
+
+	entry->checksum = checksum;
+	entry->outHash = outHash;
+}
+
+
+/*************************************************************************** 
+	Load the entries of an existing journal
+***************************************************************************/
+static void LoadJournal(const char *filename)
+{
+	FILE *in;
+	char line[1024];
+
+	in = fopen(filename, "r");
+	if(NULL == in)
+	{
+		return;
+	}
+
+	while(NULL != fgets(line, sizeof(line), in))
+	{
+		unsigned long offset;
+		unsigned long checksum;
+		unsigned long outHash;
+		char source[1024];
+		size_t length;
+
+		length = strlen(line);
+		if(0 == length || '\n' != line[length - 1])
+		{
+			/* Torn write, ignore it */
+			continue;
+		}
+		line[length - 1] = 0;
+
+		/* Lines without the input checksum are from older runs and are redone */
+		if(4 != sscanf(line, "%lx %lx %lx %[^\n]", &offset, &checksum, &outHash, source))
+		{
+			continue;
+		}
+
+		AddEntry(source, offset, checksum, outHash);
+	}
+
+	fclose(in);
+}
+
+
+/*************************************************************************** 
+	Open the journal, loading any entries from a previous run
+***************************************************************************/
+int JournalOpen(const char *filename)
+{
+	LoadJournal(filename);
+
+	journal = fopen(filename, "a");
+	if(NULL == journal)
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Check if a module was completed by a previous run. The module must
+	still have the recorded checksum, and if it was written to a file the
+	file must still hold the recorded output.
+***************************************************************************/
+BOOL JournalIsComplete(const char *source, u_int32 offset, u_int32 checksum, const char *outName)
+{
+	JournalEntry *entry;
+
+	entry = FindEntry(source, offset, EntryKey(source, offset));
+	if(NULL == entry || checksum != entry->checksum)
+	{
+		return FALSE;
+	}
+
+	return NULL == outName || HashFile(outName) == entry->outHash ? TRUE : FALSE;
+}
+
+
+/*************************************************************************** 
+	Record a completed module and flush it to disk
+***************************************************************************/
+void JournalRecord(const char *source, u_int32 offset, u_int32 checksum, u_int32 outHash)
+{
+	if(NULL == journal)
+	{
+		return;
+	}
+
+	fprintf(journal, "%08lx %08lx %08lx %s\n", (unsigned long)offset, (unsigned long)checksum, (unsigned long)outHash, source);
+	fflush(journal);
+	fsync(fileno(journal));
+}
+
+
+/*************************************************************************** 
+	Close the journal
+***************************************************************************/
+void JournalClose(void)
+{
+	if(NULL != journal)
+	{
+		fclose(journal);
+		journal = NULL;
+	}
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,528 @@
+/*****************************************************************************
+	kbench.c	- Phase benchmarks of the disassembler
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Times LoadROF, TraceObjectCode, DisasmObjectCode and DumpROFInfo over
+	every module of the input files. The inputs are read into memory once
+	and the listings are rendered to a buffer that is thrown away so the
+	disk is left out of the numbers.
+
+	A run goes over all of the modules and the time of each phase is
+	added up across them. The warm-up runs are not measured and the first
+	one counts the bytes and instructions each phase handles, which are
+	the same on every run. The trace counts each instruction it marks as
+	code and the disassembly each instruction it lists. The measured runs
+	are reported as the minimum, median, 90th percentile and maximum with
+	the throughput taken from the median.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "disasm.h"
+#include "stats.h"
+#include "hexfmt.h"
+#include "platform.h"
+
+#define MAX_INPUTS		256		/* Most input files */
+#define MEGABYTE		1048576.0
+
+typedef enum
+{
+	BENCH_LOAD,
+	BENCH_TRACE,
+	BENCH_DISASM,
+	BENCH_DUMP,
+	BENCH_COUNT
+} BENCH;
+
+typedef struct
+{
+	const char		*filename;
+	MappedFile		*mapping;
+	const u_char	*data;
+	unsigned long	length;
+	u_int32			modules;
+} Input;
+
+typedef struct
+{
+	double		bytes;			/* Bytes handled in one run */
+	double		instructions;	/* Instructions traced or listed in one run */
+	double		*samples;		/* Seconds of each measured run */
+} BenchResult;
+
+static const char *benchNames[BENCH_COUNT] =
+{
+	"LoadROF",
+	"TraceObjectCode",
+	"DisasmObjectCode",
+	"DumpROFInfo"
+};
+
+static const char *benchKeys[BENCH_COUNT] =
+{
+	"load",
+	"trace",
+	"disasm",
+	"dump"
+};
+
+static Input inputs[MAX_INPUTS];
+static int inputCount = 0;
+static BenchResult results[BENCH_COUNT];
+static PhaseStats countStats;
+static TextBuf sink;
+
+
+/*************************************************************************** 
+	Seconds since start
+***************************************************************************/
+static double Elapsed(unsigned long start)
+{
+	return (double)(GetMicroseconds() - start) / 1000000.0;
+}
+
+
+/*************************************************************************** 
+	Run every phase over each module of an input. The times are added to
+	times, and when count is set the bytes and instructions of each
+	phase are added to the results.
+***************************************************************************/
+static void RunInput(Input *input, double *times, BOOL count)
+{
+	u_int32 position;
+
+	position = 0;
+	for(;;)
+	{
+		ROFReader reader;
+		OS9ROF *rfile;
+		unsigned long start;
+		u_int32 counted;
+		double elapsed;
+		int result;
+
+		ReaderInitMemory(&reader, input->data, (u_int32)input->length);
+		reader.position = position;
+
+		start = GetMicroseconds();
+		result = LoadROFReader(&reader, &rfile, input->filename);
+		elapsed = Elapsed(start);
+		if(ROF_END == result)
+		{
+			break;
+		}
+		if(ROF_OK != result)
+		{
+			error("%s at $%lx: %s", input->filename, (unsigned long)position, GetErrorText());
+		}
+		times[BENCH_LOAD] += elapsed;
+
+		if(TRUE == count)
+		{
+			results[BENCH_LOAD].bytes += reader.position - position;
+			results[BENCH_DUMP].bytes += reader.position - position;
+			results[BENCH_TRACE].bytes += rfile->sizeObjectCode;
+			results[BENCH_DISASM].bytes += rfile->sizeObjectCode;
+			input->modules++;
+		}
+		position = reader.position;
+
+		counted = countStats.counts[STAT_TRACED_INSNS];
+		start = GetMicroseconds();
+		result = TraceObjectCode(rfile);
+		times[BENCH_TRACE] += Elapsed(start);
+		if(0 != result)
+		{
+			error("%s: %s", rfile->name, GetErrorText());
+		}
+		if(TRUE == count)
+		{
+			results[BENCH_TRACE].instructions += countStats.counts[STAT_TRACED_INSNS] - counted;
+		}
+
+		counted = countStats.counts[STAT_EMITTED_INSNS];
+		SetAsmOutputBuffer(&sink);
+		start = GetMicroseconds();
+		result = DisasmObjectCode(NULL, rfile);
+		times[BENCH_DISASM] += Elapsed(start);
+		if(0 != result)
+		{
+			error("%s: %s", rfile->name, GetErrorText());
+		}
+		if(TRUE == count)
+		{
+			results[BENCH_DISASM].instructions += countStats.counts[STAT_EMITTED_INSNS] - counted;
+		}
+		TextBufReset(&sink);
+
+		start = GetMicroseconds();
+		DumpROFInfo(NULL, rfile);
+		times[BENCH_DUMP] += Elapsed(start);
+		SetAsmOutputBuffer(NULL);
+		TextBufReset(&sink);
+
+		FreeROF(rfile);
+	}
+}
+
+
+/*************************************************************************** 
+	Run every input once
+***************************************************************************/
+static void RunInputs(double *times, BOOL count)
+{
+	int index;
+
+	memset(times, 0, sizeof(double) * BENCH_COUNT);
+
+	StatsAttach(TRUE == count ? &countStats : NULL);
+	for(index = 0; index < inputCount; index++)
+	{
+		RunInput(&inputs[index], times, count);
+	}
+	StatsAttach(NULL);
+}
+
+
+static int CompareSamples(const void *a, const void *b)
+{
+	double left;
+	double right;
+
+	left = *(const double *)a;
+	right = *(const double *)b;
+
+	return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+
+/*************************************************************************** 
+	Value at percent of the way through sorted samples, between the two
+	closest samples
+***************************************************************************/
+static double Percentile(const double *sorted, int count, double percent)
+{
+	double position;
+	int low;
+
+	position = (count - 1) * percent / 100.0;
+	low = (int)position;
+	if(low + 1 >= count)
+	{
+		return sorted[count - 1];
+	}
+
+	return sorted[low] + (sorted[low + 1] - sorted[low]) * (position - low);
+}
+
+
+/*************************************************************************** 
+	Print the results as a table
+***************************************************************************/
+static void PrintResults(FILE *outFile, int runs)
+{
+	double *sorted;
+	int bench;
+
+	sorted = malloc(sizeof(double) * runs);
+	if(NULL == sorted)
+	{
+		error("out of memory");
+	}
+
+	fprintf(outFile, "%-18s %10s %12s %10s %10s %10s %10s %10s %12s\n",
+		"phase", "bytes", "instructions", "min ms", "median ms", "p90 ms", "max ms", "MB/s", "insns/s");
+
+	for(bench = 0; bench < BENCH_COUNT; bench++)
+	{
+		double median;
+
+		memcpy(sorted, results[bench].samples, sizeof(double) * runs);
+		qsort(sorted, runs, sizeof(double), CompareSamples);
+		median = Percentile(sorted, runs, 50);
+
+		fprintf(outFile, "%-18s %10.0f %12.0f %10.3f %10.3f %10.3f %10.3f %10.2f %12.0f\n",
+			benchNames[bench],
+			results[bench].bytes,
+			results[bench].instructions,
+			sorted[0] * 1000,
+			median * 1000,
+			Percentile(sorted, runs, 90) * 1000,
+			sorted[runs - 1] * 1000,
+			0 != median ? results[bench].bytes / MEGABYTE / median : 0,
+			0 != median ? results[bench].instructions / median : 0);
+	}
+
+	free(sorted);
+}
+
+
+/*************************************************************************** 
+	Write the results as one JSON document. The times are in milliseconds
+	and the samples are in the order they were run.
+***************************************************************************/
+static int WriteResultsJson(const char *filename, int runs, int warmup, int threads)
+{
+	FILE *outFile;
+	double *sorted;
+	int bench;
+	int index;
+
+	outFile = fopen(filename, "w");
+	if(NULL == outFile)
+	{
+		SetError("can't create '%s'", filename);
+		return -1;
+	}
+
+	sorted = malloc(sizeof(double) * runs);
+	if(NULL == sorted)
+	{
+		fclose(outFile);
+		SetError("out of memory");
+		return -1;
+	}
+
+	fprintf(outFile, "{\"runs\":%d,\"warmup\":%d,\"threads\":%d,\"inputs\":[", runs, warmup, threads);
+	for(index = 0; index < inputCount; index++)
+	{
+		fprintf(outFile, "%s{\"file\":", 0 != index ? "," : "");
+		StatsPrintJsonString(outFile, inputs[index].filename);
+		fprintf(outFile, ",\"bytes\":%lu,\"modules\":%lu}", inputs[index].length, (unsigned long)inputs[index].modules);
+	}
+	fprintf(outFile, "],\"phases\":[");
+
+	for(bench = 0; bench < BENCH_COUNT; bench++)
+	{
+		double median;
+
+		memcpy(sorted, results[bench].samples, sizeof(double) * runs);
+		qsort(sorted, runs, sizeof(double), CompareSamples);
+		median = Percentile(sorted, runs, 50);
+
+		fprintf(outFile, "%s\n{\"phase\":\"%s\",\"bytes\":%.0f,\"instructions\":%.0f", 0 != bench ? "," : "", benchKeys[bench], results[bench].bytes, results[bench].instructions);
+		fprintf(outFile, ",\"min\":%.3f,\"median\":%.3f,\"p90\":%.3f,\"max\":%.3f",
+			sorted[0] * 1000,
+			median * 1000,
+			Percentile(sorted, runs, 90) * 1000,
+			sorted[runs - 1] * 1000);
+		fprintf(outFile, ",\"mb_per_s\":%.3f,\"insns_per_s\":%.0f,\"samples\":[",
+			0 != median ? results[bench].bytes / MEGABYTE / median : 0,
+			0 != median ? results[bench].instructions / median : 0);
+		for(index = 0; index < runs; index++)
+		{
+			fprintf(outFile, "%s%.3f", 0 != index ? "," : "", results[bench].samples[index] * 1000);
+		}
+		fprintf(outFile, "]}");
+	}
+	fprintf(outFile, "\n]}\n");
+
+	free(sorted);
+
+	if(0 != ferror(outFile))
+	{
+		fclose(outFile);
+		SetError("error writing '%s'", filename);
+		return -1;
+	}
+	fclose(outFile);
+
+	return 0;
+}
+
+
+void help(void)
+{
+	fprintf(stderr, "kbench:  times the phases of the disassembler\n");
+	fprintf(stderr, "usage: kbench [opts] <file> [<file> ...]\n");
+	fprintf(stderr, "options:\n");
+	fprintf(stderr, "--runs <n> - measured runs over the inputs (10)\n");
+	fprintf(stderr, "--warmup <n> - runs before measuring, at least one (2)\n");
+	fprintf(stderr, "--threads <n> - threads to render each module with (1)\n");
+	fprintf(stderr, "--json <file> - write the results as JSON to <file>\n");
+}
+
+
+/*************************************************************************** 
+	Get the numeric value of an option
+***************************************************************************/
+static int GetOptionValue(int argc, char **argv, int *index, int minimum)
+{
+	char *end;
+	long value;
+
+	if(++(*index) == argc)
+	{
+		error("missing value for %s", argv[*index - 1]);
+	}
+
+	value = strtol(argv[*index], &end, 10);
+	if(0 != *end || value < minimum || value > 100000)
+	{
+		error("bad value for %s", argv[*index - 1]);
+	}
+
+	return (int)value;
+}
+
+
+int main(int argc, char **argv)
+{
+	const char *jsonName;
+	double times[BENCH_COUNT];
+	int runs;
+	int warmup;
+	int threads;
+	int bench;
+	int run;
+	int i;
+
+	HexInit();
+	runs = 10;
+	warmup = 2;
+	threads = 1;
+	jsonName = NULL;
+
+	for(i = 1; i < argc; i++)
+	{
+		const char *p;
+
+		p = argv[i];
+
+		if(0 == strcmp(p, "-help") || 0 == strcmp(p, "--help"))
+		{
+			help();
+			exit(0);
+		}
+		else if(0 == strcmp(p, "--runs"))
+		{
+			runs = GetOptionValue(argc, argv, &i, 1);
+		}
+		else if(0 == strcmp(p, "--warmup"))
+		{
+			warmup = GetOptionValue(argc, argv, &i, 1);
+		}
+		else if(0 == strcmp(p, "--threads"))
+		{
+			threads = GetOptionValue(argc, argv, &i, 1);
+		}
+		else if(0 == strcmp(p, "--json"))
+		{
+			if(++i == argc)
+			{
+				error("missing file name for --json");
+			}
+			jsonName = argv[i];
+		}
+		else if('-' == *p)
+		{
+			error("unknown option %s", p);
+		}
+		else if(MAX_INPUTS == inputCount)
+		{
+			error("too many input files");
+		}
+		else
+		{
+			Input *input;
+			const void *data;
+
+			input = &inputs[inputCount++];
+			input->filename = p;
+			input->mapping = MapFile(p, &data, &input->length);
+			if(NULL == input->mapping)
+			{
+				error("can't open '%s'", p);
+			}
+			input->data = data;
+		}
+	}
+
+	if(0 == inputCount)
+	{
+		help();
+		exit(1);
+	}
+
+	SetRenderThreads(threads);
+	TextBufInit(&sink);
+
+	for(bench = 0; bench < BENCH_COUNT; bench++)
+	{
+		results[bench].samples = calloc(runs, sizeof(double));
+		if(NULL == results[bench].samples)
+		{
+			error("out of memory");
+		}
+	}
+
+	for(run = 0; run < warmup; run++)
+	{
+		RunInputs(times, 0 == run ? TRUE : FALSE);
+	}
+
+	for(run = 0; run < runs; run++)
+	{
+		RunInputs(times, FALSE);
+		for(bench = 0; bench < BENCH_COUNT; bench++)
+		{
+			results[bench].samples[run] = times[bench];
+		}
+	}
+
+	PrintResults(stdout, runs);
+
+	if(NULL != jsonName && 0 != WriteResultsJson(jsonName, runs, warmup, threads))
+	{
+		error("%s", GetErrorText());
+	}
+
+	for(bench = 0; bench < BENCH_COUNT; bench++)
+	{
+		free(results[bench].samples);
+	}
+	for(i = 0; i < inputCount; i++)
+	{
+		UnmapFile(inputs[i].mapping);
+	}
+	TextBufFree(&sink);
+
+	return 0;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,295 @@
+/*****************************************************************************
+	kdb.c	- Reader for binary disassembly files
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	The file is mapped and checked once when it is opened. After that the
+	accessors hand out pointers into the mapping without copying or
+	checking anything.
+
+*****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "kdb.h"
+#include "rof.h"
+#include "platform.h"
+
+struct KdbFile
+{
+	MappedFile				*mapping;	/* Mapping of the file */
+	const unsigned char		*data;		/* Contents of the file */
+	unsigned long			size;		/* Size of the file */
+	const KdbHeader			*header;	/* Header at the start of the file */
+	const KdbModuleEntry	*modules;	/* Module table */
+};
+
+
+/*************************************************************************** 
+	Check that a range lies within the file
+***************************************************************************/
+static BOOL InFile(const KdbFile *file, unsigned int offset, unsigned long length)
+{
+	return offset <= file->size && length <= file->size - offset;
+}
+
+
+/*************************************************************************** 
+	Check that a string offset lies within a string table
+***************************************************************************/
+static BOOL InStrings(const KdbModuleEntry *entry, unsigned int offset)
+{
+	return offset < entry->stringsSize;
+}
+
+
+/*************************************************************************** 
+	Check everything a module entry points to so the accessors never
+	need to.
+***************************************************************************/
+static BOOL CheckModule(const KdbFile *file, const KdbModuleEntry *entry)
+{
+	const KdbRecord *records;
+	const char *strings;
+	unsigned int index;
+
+	if(0 != (entry->recordsOffset & 3)
+		|| entry->codeRecords > entry->recordCount
+		|| entry->recordCount > (file->size / sizeof(KdbRecord))
+		|| FALSE == InFile(file, entry->recordsOffset, (unsigned long)entry->recordCount * sizeof(KdbRecord))
+		|| FALSE == InFile(file, entry->stringsOffset, entry->stringsSize)
+		|| FALSE == InFile(file, entry->blobOffset, entry->blobSize))
+	{
+		return FALSE;
+	}
+
+	/* Every string must end inside the table */
+	strings = (const char *)(file->data + entry->stringsOffset);
+	if(0 == entry->stringsSize || 0 != strings[entry->stringsSize - 1] || FALSE == InStrings(entry, entry->name))
+	{
+		return FALSE;
+	}
+
+	records = (const KdbRecord *)(file->data + entry->recordsOffset);
+	for(index = 0; index < entry->recordCount; index++)
+	{
+		const KdbRecord *record;
+
+		record = &records[index];
+		if(FALSE == InStrings(entry, record->label)
+			|| FALSE == InStrings(entry, record->mnemonic)
+			|| FALSE == InStrings(entry, record->operands)
+			|| FALSE == InStrings(entry, record->comment)
+			|| FALSE == InStrings(entry, record->refLabel)
+			|| record->bytes > entry->blobSize
+			|| record->length > entry->blobSize - record->bytes)
+		{
+			return FALSE;
+		}
+
+		/* KdbFindAddress relies on the code records being in order */
+		if(index > 0 && index < entry->codeRecords && record->address < records[index - 1].address)
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+
+/*************************************************************************** 
+	Map a .kdb file and check that it is well formed
+***************************************************************************/
+int KdbOpen(const char *filename, KdbFile **file)
+{
+	KdbFile *newFile;
+	const void *data;
+	unsigned int index;
+
+	*file = NULL;
+
+	newFile = MemAlloc(MEM_OTHER, sizeof(KdbFile));
+	if(NULL == newFile)
+	{
+		SetError("out of memory");
+		return KDISASM_ERROR;
+	}
+
+	newFile->mapping = MapFile(filename, &data, &newFile->size);
+	if(NULL == newFile->mapping)
+	{
+		MemFree(newFile);
+		SetError("can't open '%s'", filename);
+		return KDISASM_ERROR;
+	}
+	newFile->data = data;
+	newFile->header = data;
+	newFile->modules = (const KdbModuleEntry *)(newFile->data + sizeof(KdbHeader));
+
+	if(newFile->size < sizeof(KdbHeader) || 0 != memcmp(newFile->header->magic, KDB_MAGIC, sizeof(newFile->header->magic)))
+	{
+		KdbClose(newFile);
+		SetError("'%s' is not a disassembly file", filename);
+		return KDISASM_ERROR;
+	}
+
+	if(KDB_VERSION != newFile->header->version || KDB_BYTEORDER != newFile->header->byteOrder)
+	{
+		KdbClose(newFile);
+		SetError("'%s' was written by an incompatible version", filename);
+		return KDISASM_ERROR;
+	}
+
+	if(newFile->header->moduleCount > (newFile->size - sizeof(KdbHeader)) / sizeof(KdbModuleEntry))
+	{
+		KdbClose(newFile);
+		SetError("'%s' is truncated", filename);
+		return KDISASM_ERROR;
+	}
+
+	for(index = 0; index < newFile->header->moduleCount; index++)
+	{
+		if(FALSE == CheckModule(newFile, &newFile->modules[index]))
+		{
+			KdbClose(newFile);
+			SetError("module %u of '%s' is damaged", index, filename);
+			return KDISASM_ERROR;
+		}
+	}
+
+	*file = newFile;
+
+	return KDISASM_OK;
+}
+
+
+void KdbClose(KdbFile *file)
+{
+	if(NULL == file)
+	{
+		return;
+	}
+
+	UnmapFile(file->mapping);
+	MemFree(file);
+}
+
+
+unsigned int KdbGetModuleCount(const KdbFile *file)
+{
+	return file->header->moduleCount;
+}
+
+
+/*************************************************************************** 
+	Fill in a view of a module
+***************************************************************************/
+int KdbGetModule(const KdbFile *file, unsigned int index, KdbModule *module)
+{
+	const KdbModuleEntry *entry;
+
+	if(index >= file->header->moduleCount)
+	{
+		return KDISASM_END;
+	}
+
+	entry = &file->modules[index];
+	module->strings = (const char *)(file->data + entry->stringsOffset);
+	module->name = module->strings + entry->name;
+	module->records = (const KdbRecord *)(file->data + entry->recordsOffset);
+	module->recordCount = entry->recordCount;
+	module->codeRecords = entry->codeRecords;
+	module->blob = file->data + entry->blobOffset;
+	module->codeSize = entry->codeSize;
+	module->dataSize = entry->dataSize;
+
+	return KDISASM_OK;
+}
+
+
+int KdbFindModule(const KdbFile *file, const char *name, KdbModule *module)
+{
+	unsigned int index;
+
+	for(index = 0; index < file->header->moduleCount; index++)
+	{
+		const KdbModuleEntry *entry;
+
+		entry = &file->modules[index];
+		if(0 == strcmp((const char *)(file->data + entry->stringsOffset + entry->name), name))
+		{
+			return KdbGetModule(file, index, module);
+		}
+	}
+
+	SetError("module '%s' not found", name);
+	return KDISASM_ERROR;
+}
+
+
+/*************************************************************************** 
+	Find the code record covering an address
+***************************************************************************/
+const KdbRecord *KdbFindAddress(const KdbModule *module, unsigned int address)
+{
+	unsigned int low;
+	unsigned int high;
+
+	low = 0;
+	high = module->codeRecords;
+	while(low < high)
+	{
+		unsigned int middle;
+
+		middle = low + (high - low) / 2;
+		if(module->records[middle].address <= address)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	if(0 == low || address >= (unsigned int)module->records[low - 1].address + module->records[low - 1].length)
+	{
+		return NULL;
+	}
+
+	return &module->records[low - 1];
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,157 @@
+/*****************************************************************************
+	kdb.h	- Memory mappable binary disassembly format and reader
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	A .kdb file holds the disassembly of every module in a source file so
+	tools can query it without disassembling again. Values are stored in
+	the byte order of the machine that wrote the file and every structure
+	is a multiple of 4 bytes so the file can be used directly once it is
+	mapped.
+
+		KdbHeader
+		KdbModuleEntry[moduleCount]
+		for each module:
+			KdbRecord[recordCount]	code records sorted by address,
+									followed by initialized data records
+			strings					null terminated, offset 0 is ""
+			blob					instruction and data bytes
+
+	Offsets in KdbModuleEntry are from the start of the file. Offsets in
+	KdbRecord are into the string table or blob of the module.
+
+*****************************************************************************/
+#ifndef KDB_H
+#define KDB_H
+
+#include "kdisasm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KDB_MAGIC			"KDB1"
+#define KDB_VERSION			1
+#define KDB_BYTEORDER		0x01020304	/* Stored as written so readers can check byte order */
+
+#define KDB_INSN			0		/* Record is an instruction */
+#define KDB_DATA			1		/* Record is a run of data */
+
+#define KDB_SECTION_CODE	0		/* Record is in the code */
+#define KDB_SECTION_DATA	1		/* Record is in the initialized data */
+
+#define KDB_REF_NONE		0		/* Operand does not reference anything */
+#define KDB_REF_CODE		1		/* Operand references the code */
+#define KDB_REF_DATA		2		/* Operand references initialized data */
+#define KDB_REF_BSS			3		/* Operand references uninitialized data */
+#define KDB_REF_EXTERNAL	4		/* Operand references an external symbol */
+#define KDB_REF_ABSOLUTE	5		/* Operand is an address outside the module */
+
+
+typedef struct
+{
+	char				magic[4];		/* KDB_MAGIC */
+	unsigned int		version;		/* KDB_VERSION */
+	unsigned int		byteOrder;		/* KDB_BYTEORDER */
+	unsigned int		moduleCount;	/* Number of entries in the module table */
+} KdbHeader;
+
+typedef struct
+{
+	unsigned int		name;			/* Module name in the string table */
+	unsigned int		recordsOffset;	/* File offset of the records */
+	unsigned int		recordCount;	/* Number of records */
+	unsigned int		codeRecords;	/* Number of records in the code */
+	unsigned int		stringsOffset;	/* File offset of the string table */
+	unsigned int		stringsSize;	/* Size of the string table */
+	unsigned int		blobOffset;		/* File offset of the bytes */
+	unsigned int		blobSize;		/* Size of the bytes */
+	unsigned short		codeSize;		/* Size of the code */
+	unsigned short		dataSize;		/* Size of the initialized data */
+	unsigned int		reserved;
+} KdbModuleEntry;
+
+typedef struct
+{
+	unsigned short		address;		/* Address of the record in its section */
+	unsigned short		length;			/* Number of bytes covered */
+	unsigned char		type;			/* KDB_INSN or KDB_DATA */
+	unsigned char		section;		/* KDB_SECTION_xxx */
+	unsigned char		refKind;		/* KDB_REF_xxx */
+	unsigned char		reserved;
+	unsigned short		refTarget;		/* Address the operand references */
+	unsigned short		reserved2;
+	unsigned int		bytes;			/* Offset of the bytes in the blob */
+	unsigned int		label;			/* String offsets, 0 when there is none */
+	unsigned int		mnemonic;
+	unsigned int		operands;
+	unsigned int		comment;
+	unsigned int		refLabel;
+} KdbRecord;
+
+
+typedef struct KdbFile KdbFile;
+
+/* View of one module in a mapped file. Nothing is copied. */
+typedef struct
+{
+	const char			*name;			/* Name of the module */
+	const KdbRecord		*records;		/* All records of the module */
+	unsigned int		recordCount;	/* Number of records */
+	unsigned int		codeRecords;	/* Number of records in the code */
+	const char			*strings;		/* String table */
+	const unsigned char	*blob;			/* Instruction and data bytes */
+	unsigned int		codeSize;		/* Size of the code */
+	unsigned int		dataSize;		/* Size of the initialized data */
+} KdbModule;
+
+#define KdbString(module, offset)		((module)->strings + (offset))
+#define KdbBytes(module, record)		((module)->blob + (record)->bytes)
+
+
+int KdbOpen(const char *filename, KdbFile **file);
+void KdbClose(KdbFile *file);
+unsigned int KdbGetModuleCount(const KdbFile *file);
+int KdbGetModule(const KdbFile *file, unsigned int index, KdbModule *module);
+int KdbFindModule(const KdbFile *file, const char *name, KdbModule *module);
+const KdbRecord *KdbFindAddress(const KdbModule *module, unsigned int address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* KDB_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
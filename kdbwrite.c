@@ -0,0 +1,447 @@
+/*****************************************************************************
+	kdbwrite.c	- Generation of binary disassembly files
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kdbwrite.h"
+
+#define INITIAL_RECORDS		256		/* Records allocated when a table is first used */
+#define INITIAL_SLOTS		256		/* Hash slots allocated for the string table */
+
+
+/*************************************************************************** 
+	Make room for at least one more element in a table
+***************************************************************************/
+static BOOL Reserve(KdbWriter *writer, void **table, u_int32 *size, u_int32 used, u_int32 needed, u_int32 elementSize, u_int32 initial)
+{
+	u_int32 newSize;
+	void *newTable;
+
+	if(TRUE == writer->failed)
+	{
+		return FALSE;
+	}
+
+	if(used + needed <= *size)
+	{
+		return TRUE;
+	}
+
+	newSize = 0 != *size ? *size : initial;
+	while(newSize < used + needed)
+	{
+		newSize *= 2;
+	}
+
+	newTable = MemRealloc(MEM_OUTPUT, *table, newSize * elementSize);
+	if(NULL == newTable)
+	{
+		writer->failed = TRUE;
+		return FALSE;
+	}
+
+	*table = newTable;
+	*size = newSize;
+
+	return TRUE;
+}
+
+
+/*************************************************************************** 
+	Rebuild the string hash with twice as many slots
+***************************************************************************/
+static BOOL GrowSlots(KdbWriter *writer)
+{
+	unsigned int *slots;
+	u_int32 count;
+	u_int32 index;
+
+	count = 0 != writer->slotCount ? writer->slotCount * 2 : INITIAL_SLOTS;
+	slots = MemAlloc(MEM_OUTPUT, count * sizeof(unsigned int));
+	if(NULL == slots)
+	{
+		writer->failed = TRUE;
+		return FALSE;
+	}
+
+	for(index = 0; index < writer->slotCount; index++)
+	{
+		unsigned int offset;
+		u_int32 slot;
+
+		offset = writer->slots[index];
+		if(0 == offset)
+		{
+			continue;
+		}
+
+		slot = HashBytes(HASH_INIT, (const u_char *)&writer->strings[offset], (u_int32)strlen(&writer->strings[offset])) & (count - 1);
+		while(0 != slots[slot])
+		{
+			slot = (slot + 1) & (count - 1);
+		}
+		slots[slot] = offset;
+	}
+
+	MemFree(writer->slots);
+	writer->slots = slots;
+	writer->slotCount = count;
+
+	return TRUE;
+}
+
+
+/*************************************************************************** 
+	Add a string to the string table. Repeated strings are stored once
+	since most of the operands and comments of a module reuse the same
+	few labels. Empty strings are offset 0.
+***************************************************************************/
+static unsigned int AddString(KdbWriter *writer, const char *text)
+{
+	u_int32 length;
+	u_int32 slot;
+	unsigned int offset;
+
+	if(NULL == text || 0 == *text || TRUE == writer->failed)
+	{
+		return 0;
+	}
+
+	if(writer->slotsUsed * 2 >= writer->slotCount && FALSE == GrowSlots(writer))
+	{
+		return 0;
+	}
+
+	length = (u_int32)strlen(text);
+	slot = HashBytes(HASH_INIT, (const u_char *)text, length) & (writer->slotCount - 1);
+	while(0 != (offset = writer->slots[slot]))
+	{
+		if(0 == strcmp(&writer->strings[offset], text))
+		{
+			return offset;
+		}
+		slot = (slot + 1) & (writer->slotCount - 1);
+	}
+
+	if(FALSE == Reserve(writer, (void **)&writer->strings, &writer->stringsSize, writer->stringsLength, length + 1, 1, 4096))
+	{
+		return 0;
+	}
+
+	offset = (unsigned int)writer->stringsLength;
+	memcpy(&writer->strings[offset], text, length + 1);
+	writer->stringsLength += length + 1;
+
+	writer->slots[slot] = offset;
+	writer->slotsUsed++;
+
+	return offset;
+}
+
+
+/*************************************************************************** 
+	Add bytes to the blob
+***************************************************************************/
+static unsigned int AddBytes(KdbWriter *writer, const u_char *bytes, u_int32 length)
+{
+	unsigned int offset;
+
+	if(FALSE == Reserve(writer, (void **)&writer->blob, &writer->blobSize, writer->blobLength, length, 1, 4096))
+	{
+		return 0;
+	}
+
+	offset = (unsigned int)writer->blobLength;
+	memcpy(&writer->blob[offset], bytes, length);
+	writer->blobLength += length;
+
+	return offset;
+}
+
+
+/*************************************************************************** 
+	Allocate the next record of a section
+***************************************************************************/
+static KdbRecord *AddRecord(KdbWriter *writer, int section)
+{
+	KdbRecord *record;
+
+	if(SECTION_CODE == section)
+	{
+		if(FALSE == Reserve(writer, (void **)&writer->code, &writer->codeSize, writer->codeCount, 1, sizeof(KdbRecord), INITIAL_RECORDS))
+		{
+			return NULL;
+		}
+		record = &writer->code[writer->codeCount++];
+	}
+	else
+	{
+		if(FALSE == Reserve(writer, (void **)&writer->data, &writer->dataSize, writer->dataCount, 1, sizeof(KdbRecord), INITIAL_RECORDS))
+		{
+			return NULL;
+		}
+		record = &writer->data[writer->dataCount++];
+	}
+
+	memset(record, 0, sizeof(KdbRecord));
+	record->section = (unsigned char)section;
+
+	return record;
+}
+
+
+/*************************************************************************** 
+	Start collecting a module
+***************************************************************************/
+static void KdbSinkModule(RecordSink *sink, FILE *outFile, OS9ROF *rfile)
+{
+	KdbWriter *writer;
+
+	(void)outFile;
+
+	writer = sink->context;
+
+	writer->codeCount = 0;
+	writer->dataCount = 0;
+	writer->blobLength = 0;
+	writer->stringsLength = 0;
+	writer->slotsUsed = 0;
+	if(NULL != writer->slots)
+	{
+		memset(writer->slots, 0, writer->slotCount * sizeof(unsigned int));
+	}
+
+	/* Offset 0 is the empty string */
+	if(TRUE == Reserve(writer, (void **)&writer->strings, &writer->stringsSize, 0, 1, 1, 4096))
+	{
+		writer->strings[0] = 0;
+		writer->stringsLength = 1;
+	}
+
+	memset(&writer->entry, 0, sizeof(writer->entry));
+	writer->entry.name = AddString(writer, rfile->name);
+	writer->entry.codeSize = (unsigned short)rfile->sizeObjectCode;
+	writer->entry.dataSize = (unsigned short)rfile->sizeInitData;
+}
+
+
+/*************************************************************************** 
+	Collect a decoded instruction
+***************************************************************************/
+static void KdbSinkInstruction(RecordSink *sink, FILE *outFile, const AsmRecord *record, const u_char *bytes)
+{
+	KdbWriter *writer;
+	KdbRecord *out;
+
+	(void)outFile;
+
+	writer = sink->context;
+
+	out = AddRecord(writer, SECTION_CODE);
+	if(NULL == out)
+	{
+		return;
+	}
+
+	out->address = record->address;
+	out->length = record->length;
+	out->type = KDB_INSN;
+	out->refKind = (unsigned char)record->refKind;
+	out->refTarget = record->refTarget;
+	out->bytes = AddBytes(writer, bytes, record->length);
+	out->label = AddString(writer, record->label);
+	out->mnemonic = AddString(writer, record->mnemonic);
+	out->operands = AddString(writer, record->operands);
+	out->comment = AddString(writer, record->comment);
+	out->refLabel = AddString(writer, record->refLabel);
+}
+
+
+/*************************************************************************** 
+	Collect a run of data
+***************************************************************************/
+static void KdbSinkData(RecordSink *sink, FILE *outFile, int section, const u_char *bytes, u_int16 address, u_int16 length)
+{
+	KdbWriter *writer;
+	KdbRecord *out;
+
+	(void)outFile;
+
+	writer = sink->context;
+
+	out = AddRecord(writer, section);
+	if(NULL == out)
+	{
+		return;
+	}
+
+	out->address = address;
+	out->length = length;
+	out->type = KDB_DATA;
+	out->bytes = AddBytes(writer, bytes, length);
+}
+
+
+/*************************************************************************** 
+	Generate the chunk of the collected module
+***************************************************************************/
+static void KdbSinkEnd(RecordSink *sink, FILE *outFile)
+{
+	static const char padding[4] = {0, 0, 0, 0};
+	KdbWriter *writer;
+	u_int32 stringsPadded;
+
+	writer = sink->context;
+	if(TRUE == writer->failed)
+	{
+		return;
+	}
+
+	stringsPadded = (writer->stringsLength + 3) & ~3UL;
+
+	writer->entry.recordCount = (unsigned int)(writer->codeCount + writer->dataCount);
+	writer->entry.codeRecords = (unsigned int)writer->codeCount;
+	writer->entry.recordsOffset = sizeof(KdbModuleEntry);
+	writer->entry.stringsOffset = writer->entry.recordsOffset + writer->entry.recordCount * sizeof(KdbRecord);
+	writer->entry.stringsSize = (unsigned int)writer->stringsLength;
+	writer->entry.blobOffset = writer->entry.stringsOffset + (unsigned int)stringsPadded;
+	writer->entry.blobSize = (unsigned int)writer->blobLength;
+
+	GenRawBytes(outFile, &writer->entry, sizeof(writer->entry));
+	GenRawBytes(outFile, writer->code, writer->codeCount * sizeof(KdbRecord));
+	GenRawBytes(outFile, writer->data, writer->dataCount * sizeof(KdbRecord));
+	GenRawBytes(outFile, writer->strings, writer->stringsLength);
+	GenRawBytes(outFile, padding, stringsPadded - writer->stringsLength);
+	GenRawBytes(outFile, writer->blob, writer->blobLength);
+}
+
+
+/*************************************************************************** 
+	Set up a sink that collects binary records into a writer
+***************************************************************************/
+void KdbSinkInit(RecordSink *sink, KdbWriter *writer)
+{
+	memset(writer, 0, sizeof(KdbWriter));
+
+	sink->module = KdbSinkModule;
+	sink->instruction = KdbSinkInstruction;
+	sink->data = KdbSinkData;
+	sink->end = KdbSinkEnd;
+	sink->context = writer;
+	sink->output = NULL;
+	sink->next = NULL;
+}
+
+
+void KdbWriterFree(KdbWriter *writer)
+{
+	MemFree(writer->code);
+	MemFree(writer->data);
+	MemFree(writer->strings);
+	MemFree(writer->slots);
+	MemFree(writer->blob);
+	memset(writer, 0, sizeof(KdbWriter));
+}
+
+
+BOOL KdbWriterFailed(const KdbWriter *writer)
+{
+	return writer->failed;
+}
+
+
+/*************************************************************************** 
+	Write a .kdb file from the module chunks of a source file. The
+	offsets of each chunk are moved from the start of the chunk to the
+	start of the file.
+***************************************************************************/
+int KdbAssemble(FILE *outFile, TextBuf *chunks, u_int32 count)
+{
+	KdbHeader header;
+	u_int32 position;
+	u_int32 index;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, KDB_MAGIC, sizeof(header.magic));
+	header.version = KDB_VERSION;
+	header.byteOrder = KDB_BYTEORDER;
+	header.moduleCount = (unsigned int)count;
+	fwrite(&header, sizeof(header), 1, outFile);
+
+	position = sizeof(KdbHeader) + count * sizeof(KdbModuleEntry);
+	for(index = 0; index < count; index++)
+	{
+		KdbModuleEntry entry;
+		u_int32 base;
+
+		if(chunks[index].length < sizeof(KdbModuleEntry))
+		{
+			SetError("module %lu has no records", index);
+			return -1;
+		}
+
+		memcpy(&entry, chunks[index].text, sizeof(entry));
+		base = position - sizeof(KdbModuleEntry);
+		entry.recordsOffset += (unsigned int)base;
+		entry.stringsOffset += (unsigned int)base;
+		entry.blobOffset += (unsigned int)base;
+		fwrite(&entry, sizeof(entry), 1, outFile);
+
+		position += chunks[index].length - sizeof(KdbModuleEntry);
+		position = (position + 3) & ~3UL;
+	}
+
+	for(index = 0; index < count; index++)
+	{
+		static const char padding[4] = {0, 0, 0, 0};
+		u_int32 length;
+
+		length = chunks[index].length - sizeof(KdbModuleEntry);
+		fwrite(chunks[index].text + sizeof(KdbModuleEntry), 1, length, outFile);
+		fwrite(padding, 1, ((length + 3) & ~3UL) - length, outFile);
+	}
+
+	if(0 != ferror(outFile))
+	{
+		SetError("error writing output");
+		return -1;
+	}
+
+	return 0;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,79 @@
+/*****************************************************************************
+	kdbwrite.h	- Generation of binary disassembly files
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#ifndef KDBWRITE_H
+#define KDBWRITE_H
+
+#include "rof.h"
+#include "genasm.h"
+#include "textbuf.h"
+#include "kdb.h"
+
+/*
+	Collects the records of one module. When the module ends the writer
+	generates a chunk holding a KdbModuleEntry followed by the records,
+	strings, and bytes with offsets relative to the start of the chunk.
+	KdbAssemble joins the chunks of a source file into a .kdb file.
+*/
+typedef struct
+{
+	KdbRecord	*code;			/* Records in the code */
+	u_int32		codeCount;
+	u_int32		codeSize;
+	KdbRecord	*data;			/* Records in the initialized data */
+	u_int32		dataCount;
+	u_int32		dataSize;
+	char		*strings;		/* String table */
+	u_int32		stringsLength;
+	u_int32		stringsSize;
+	unsigned int	*slots;		/* Hash of string offsets, 0 is empty */
+	u_int32		slotCount;
+	u_int32		slotsUsed;
+	u_char		*blob;			/* Instruction and data bytes */
+	u_int32		blobLength;
+	u_int32		blobSize;
+	KdbModuleEntry	entry;		/* Module being collected */
+	BOOL		failed;			/* Ran out of memory */
+} KdbWriter;
+
+void KdbSinkInit(RecordSink *sink, KdbWriter *writer);
+void KdbWriterFree(KdbWriter *writer);
+BOOL KdbWriterFailed(const KdbWriter *writer);
+int KdbAssemble(FILE *outFile, TextBuf *chunks, u_int32 count);
+
+#endif	/* KDBWRITE_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,688 @@
+/*****************************************************************************
+	kdisasm.c	- Library interface for embedding the disassembler
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kdisasm.h"
+#include "disasm.h"
+#include "genasm.h"
+#include "textbuf.h"
+#include "platform.h"
+
+
+struct KDisasmModule
+{
+	OS9ROF		*rfile;		/* Loaded module */
+	BOOL		traced;		/* Set once KDisasmTrace succeeds */
+	u_int16		pc;			/* Next line returned by KDisasmNextInstruction */
+	TextBuf		line;		/* Text of the last line returned */
+	Hints		*hints;		/* Hints from KDisasmSetHints, NULL for none */
+	TextBuf		listing;	/* Listing kept up to date while the module is active */
+	BOOL		listingValid;	/* Set when listing holds the listing of the module */
+};
+
+
+static KDisasmModule *activeModule = NULL;	/* Module held in the trace tables */
+static u_int32 loadedModules = 0;			/* Modules not yet freed */
+
+/*
+	The trace tables are shared by every module so the library belongs to
+	one thread at a time. The first thread to load a module owns it until
+	all of the modules are freed.
+*/
+static volatile long ownerThread = 0;		/* Token of the owning thread, 0 for none */
+static volatile long lastThreadToken = 0;
+static THREAD_LOCAL long threadToken = 0;	/* Token of this thread, 0 until it uses the library */
+
+
+
+/*************************************************************************** 
+	Make sure the calling thread owns the library, taking it if no thread
+	does
+***************************************************************************/
+static int ClaimLibrary(void)
+{
+	long owner;
+
+	if(0 == threadToken)
+	{
+		threadToken = AtomicAdd(&lastThreadToken, 1);
+	}
+
+	owner = AtomicCompareExchange(&ownerThread, 0, threadToken);
+	if(0 != owner && threadToken != owner)
+	{
+		SetError("the library is in use by another thread");
+		return KDISASM_ERROR;
+	}
+
+	return KDISASM_OK;
+}
+
+
+/*************************************************************************** 
+	Let another thread take the library once no modules are loaded
+***************************************************************************/
+static void ReleaseLibrary(void)
+{
+	if(0 == loadedModules)
+	{
+		AtomicStore(&ownerThread, 0);
+	}
+}
+
+
+/*************************************************************************** 
+	Trace a module and run the first disassembly pass so its lines can
+	be generated. Nothing is done if it is already the active module.
+***************************************************************************/
+static int ActivateModule(KDisasmModule *module)
+{
+	int result;
+
+	if(KDISASM_OK != ClaimLibrary())
+	{
+		return KDISASM_ERROR;
+	}
+
+	if(module == activeModule)
+	{
+		return KDISASM_OK;
+	}
+
+	activeModule = NULL;
+	module->listingValid = FALSE;
+
+	SetDisasmHints(module->hints);
+	if(0 != TraceObjectCode(module->rfile))
+	{
+		return KDISASM_ERROR;
+	}
+
+	/* The second pass title is not part of any line */
+	SetAsmOutputBuffer(&module->line);
+	result = DisasmPrepare(NULL, module->rfile);
+	SetAsmOutputBuffer(NULL);
+	TextBufReset(&module->line);
+
+	if(0 != result)
+	{
+		return KDISASM_ERROR;
+	}
+
+	activeModule = module;
+
+	return KDISASM_OK;
+}
+
+
+/*************************************************************************** 
+	Load the module starting at *offset in a block of memory. On success
+	*offset is moved past the module so the next call loads the one that
+	follows. Returns KDISASM_END when there are no more modules.
+***************************************************************************/
+int KDisasmLoad(const void *data, unsigned long length, unsigned long *offset, KDisasmModule **module)
+{
+	ROFReader reader;
+	KDisasmModule *newModule;
+	OS9ROF *rfile;
+	int result;
+
+	*module = NULL;
+
+	if(KDISASM_OK != ClaimLibrary())
+	{
+		return KDISASM_ERROR;
+	}
+
+	ReaderInitMemory(&reader, data, (u_int32)length);
+	if(NULL != offset)
+	{
+		if(*offset >= length)
+		{
+			ReleaseLibrary();
+			return KDISASM_END;
+		}
+		reader.position = (u_int32)*offset;
+	}
+
+	result = LoadROFReader(&reader, &rfile, "<memory>");
+	if(ROF_END == result)
+	{
+		ReleaseLibrary();
+		return KDISASM_END;
+	}
+
+	if(ROF_OK != result)
+	{
+		ReleaseLibrary();
+		return KDISASM_ERROR;
+	}
+
+	newModule = MemAlloc(MEM_OTHER, sizeof(KDisasmModule));
+	if(NULL == newModule)
+	{
+		FreeROF(rfile);
+		SetError("out of memory");
+		ReleaseLibrary();
+		return KDISASM_ERROR;
+	}
+
+	newModule->rfile = rfile;
+	TextBufInit(&newModule->line);
+	TextBufInit(&newModule->listing);
+
+	if(NULL != offset)
+	{
+		*offset = reader.position;
+	}
+
+	*module = newModule;
+	loadedModules++;
+
+	return KDISASM_OK;
+}
+
+
+/*************************************************************************** 
+	Release a module returned by KDisasmLoad. Nothing is done when called
+	from a thread that does not own the library.
+***************************************************************************/
+void KDisasmFree(KDisasmModule *module)
+{
+	if(NULL == module || KDISASM_OK != ClaimLibrary())
+	{
+		return;
+	}
+
+	if(module == activeModule)
+	{
+		activeModule = NULL;
+		SetDisasmHints(NULL);
+	}
+
+	FreeROF(module->rfile);
+	FreeHints(module->hints);
+	TextBufFree(&module->line);
+	TextBufFree(&module->listing);
+	MemFree(module);
+
+	loadedModules--;
+	ReleaseLibrary();
+}
+
+
+const char *KDisasmGetName(const KDisasmModule *module)
+{
+	return module->rfile->name;
+}
+
+
+unsigned int KDisasmGetCodeSize(const KDisasmModule *module)
+{
+	return module->rfile->sizeObjectCode;
+}
+
+
+/*************************************************************************** 
+	Use a hints file for a module, or no hints if filename is NULL. When
+	the module is the one in use only the parts of it that the change
+	reaches are traced and generated again, so hints can be edited
+	interactively.
+***************************************************************************/
+int KDisasmSetHints(KDisasmModule *module, const char *filename)
+{
+	Hints *hints;
+	int result;
+
+	if(KDISASM_OK != ClaimLibrary())
+	{
+		return KDISASM_ERROR;
+	}
+
+	hints = NULL;
+	if(NULL != filename && 0 != LoadHints(filename, &hints))
+	{
+		return KDISASM_ERROR;
+	}
+
+	result = KDISASM_OK;
+	if(module == activeModule)
+	{
+		if(0 != DisasmUpdateHints(hints, TRUE == module->listingValid ? &module->listing : NULL))
+		{
+			/* The module is traced again from scratch when it is next used */
+			activeModule = NULL;
+			result = KDISASM_ERROR;
+		}
+	}
+
+	FreeHints(module->hints);
+	module->hints = hints;
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Trace the code of a module. This must be done before its
+	instructions can be iterated or rendered.
+***************************************************************************/
+int KDisasmTrace(KDisasmModule *module)
+{
+	int result;
+
+	if(module == activeModule)
+	{
+		activeModule = NULL;
+	}
+
+	result = ActivateModule(module);
+	module->traced = KDISASM_OK == result ? TRUE : FALSE;
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Iterate the lines in the code of a traced module. Each line is a
+	single instruction or a run of bytes that were not traced as code.
+***************************************************************************/
+int KDisasmFirstInstruction(KDisasmModule *module, KDisasmInstruction *insn)
+{
+	module->pc = 0;
+
+	return KDisasmNextInstruction(module, insn);
+}
+
+
+int KDisasmNextInstruction(KDisasmModule *module, KDisasmInstruction *insn)
+{
+	DisasmLineInfo line;
+	int result;
+
+	if(FALSE == module->traced)
+	{
+		SetError("module '%s' has not been traced", module->rfile->name);
+		return KDISASM_ERROR;
+	}
+
+	if(KDISASM_OK != ActivateModule(module))
+	{
+		return KDISASM_ERROR;
+	}
+
+	if(module->pc >= module->rfile->sizeObjectCode)
+	{
+		return KDISASM_END;
+	}
+
+	TextBufReset(&module->line);
+	SetAsmOutputBuffer(&module->line);
+	result = DisasmLine(NULL, module->pc, &line);
+	SetAsmOutputBuffer(NULL);
+
+	if(0 != result)
+	{
+		return KDISASM_ERROR;
+	}
+
+	insn->address = line.address;
+	insn->length = line.length;
+	insn->isCode = TRUE == line.code;
+	insn->bytes = module->rfile->objectCode + line.address;
+	insn->text = NULL != module->line.text ? module->line.text : "";
+	insn->textLength = module->line.length;
+
+	module->pc += line.length;
+
+	return KDISASM_OK;
+}
+
+
+/*************************************************************************** 
+	Render the complete listing of a traced module into a caller supplied
+	buffer. *length receives the size of the listing without the
+	terminating null even when the buffer is too small to hold it.
+***************************************************************************/
+int KDisasmRender(KDisasmModule *module, char *buffer, unsigned long size, unsigned long *length)
+{
+	TextBuf output;
+	int result;
+
+	if(FALSE == module->traced)
+	{
+		SetError("module '%s' has not been traced", module->rfile->name);
+		return KDISASM_ERROR;
+	}
+
+	if(KDISASM_OK != ActivateModule(module))
+	{
+		return KDISASM_ERROR;
+	}
+
+	TextBufInit(&output);
+	SetAsmOutputBuffer(&output);
+	result = 0 == DisasmObjectCode(NULL, module->rfile) ? KDISASM_OK : KDISASM_ERROR;
+	SetAsmOutputBuffer(NULL);
+
+	if(KDISASM_OK == result)
+	{
+		if(NULL != length)
+		{
+			*length = output.length;
+		}
+
+		if(output.length >= size)
+		{
+			SetError("buffer too small, %lu bytes needed", (unsigned long)output.length + 1);
+			result = KDISASM_ERROR;
+		}
+		else if(0 != output.length)
+		{
+			memcpy(buffer, output.text, output.length + 1);
+		}
+		else
+		{
+			*buffer = 0;
+		}
+	}
+
+	TextBufFree(&output);
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Initialize and release a render buffer
+***************************************************************************/
+void KDisasmBufferInit(KDisasmBuffer *buffer)
+{
+	memset(buffer, 0, sizeof(KDisasmBuffer));
+}
+
+
+void KDisasmBufferFree(KDisasmBuffer *buffer)
+{
+	MemFree(buffer->text);
+	MemFree(buffer->lines);
+	KDisasmBufferInit(buffer);
+}
+
+
+/*************************************************************************** 
+	Lend the memory of a render buffer to a text buffer so the generators
+	write straight into it, and take it back once rendering is done.
+***************************************************************************/
+static void BorrowBuffer(KDisasmBuffer *buffer, TextBuf *text)
+{
+	text->text = buffer->text;
+	text->length = 0;
+	text->size = buffer->size;
+
+	TextBufReset(text);
+}
+
+
+static void ReturnBuffer(KDisasmBuffer *buffer, TextBuf *text)
+{
+	buffer->text = text->text;
+	buffer->length = text->length;
+	buffer->size = text->size;
+}
+
+
+/*************************************************************************** 
+	Record the offset of the start of every line in a render buffer
+***************************************************************************/
+static int IndexLines(KDisasmBuffer *buffer)
+{
+	const char *text;
+	const char *end;
+
+	buffer->lineCount = 0;
+
+	text = buffer->text;
+	end = text + buffer->length;
+	while(text < end)
+	{
+		if(buffer->lineCount == buffer->lineSize)
+		{
+			unsigned long *lines;
+			unsigned long size;
+
+			size = 0 == buffer->lineSize ? 256 : buffer->lineSize * 2;
+			lines = MemRealloc(MEM_OUTPUT, buffer->lines, size * sizeof(unsigned long));
+			if(NULL == lines)
+			{
+				SetError("out of memory");
+				return KDISASM_ERROR;
+			}
+
+			buffer->lines = lines;
+			buffer->lineSize = size;
+		}
+
+		buffer->lines[buffer->lineCount++] = (unsigned long)(text - buffer->text);
+
+		text = memchr(text, '\n', end - text);
+		if(NULL == text)
+		{
+			break;
+		}
+		text++;
+	}
+
+	return KDISASM_OK;
+}
+
+
+/*************************************************************************** 
+	Render the complete listing of a traced module into a render buffer.
+	The listing is kept with the module while it is in use and only the
+	lines that change with its hints are generated again.
+***************************************************************************/
+int KDisasmRenderBuffer(KDisasmModule *module, KDisasmBuffer *buffer)
+{
+	TextBuf output;
+	int result;
+
+	if(FALSE == module->traced)
+	{
+		SetError("module '%s' has not been traced", module->rfile->name);
+		return KDISASM_ERROR;
+	}
+
+	if(KDISASM_OK != ActivateModule(module))
+	{
+		return KDISASM_ERROR;
+	}
+
+	if(FALSE == module->listingValid)
+	{
+		if(0 != DisasmRenderListing(&module->listing))
+		{
+			return KDISASM_ERROR;
+		}
+
+		module->listingValid = TRUE;
+	}
+
+	BorrowBuffer(buffer, &output);
+	result = TextBufWrite(&output, NULL != module->listing.text ? module->listing.text : "", module->listing.length);
+	ReturnBuffer(buffer, &output);
+
+	if(result < 0)
+	{
+		SetError("out of memory");
+		return KDISASM_ERROR;
+	}
+
+	return IndexLines(buffer);
+}
+
+
+/*************************************************************************** 
+	Render the code lines of a traced module that overlap the addresses
+	from start up to but not including end. Labels come from the trace
+	of the whole module but only the lines in the range are generated.
+***************************************************************************/
+int KDisasmRenderRange(KDisasmModule *module, unsigned int start, unsigned int end, KDisasmBuffer *buffer)
+{
+	TextBuf output;
+	int result;
+
+	if(FALSE == module->traced)
+	{
+		SetError("module '%s' has not been traced", module->rfile->name);
+		return KDISASM_ERROR;
+	}
+
+	if(KDISASM_OK != ActivateModule(module))
+	{
+		return KDISASM_ERROR;
+	}
+
+	if(end > module->rfile->sizeObjectCode)
+	{
+		end = module->rfile->sizeObjectCode;
+	}
+
+	BorrowBuffer(buffer, &output);
+	if(start < end)
+	{
+		SetAsmOutputBuffer(&output);
+		result = 0 == DisasmRange(NULL, (u_int16)start, (u_int16)end) ? KDISASM_OK : KDISASM_ERROR;
+		SetAsmOutputBuffer(NULL);
+	}
+	else
+	{
+		result = KDISASM_OK;
+	}
+	ReturnBuffer(buffer, &output);
+
+	if(KDISASM_OK == result)
+	{
+		result = IndexLines(buffer);
+	}
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Find the code covered by a global symbol. The symbol runs up to the
+	next global symbol in the code or the end of the code.
+***************************************************************************/
+int KDisasmFindSymbol(const KDisasmModule *module, const char *symbol, unsigned int *start, unsigned int *end)
+{
+	Reference *found;
+	Node *node;
+
+	found = NULL;
+	node = ListGetHead(module->rfile->refList);
+	while(NULL != node)
+	{
+		Reference *ref;
+
+		ref = NodeGetData(node);
+		if(REF_GLOBAL == ref->type && 0 != (ref->flag & CODENT) && 0 == strcmp(ref->symbol, symbol))
+		{
+			found = ref;
+			break;
+		}
+
+		node = NodeGetNext(module->rfile->refList, node);
+	}
+
+	if(NULL == found)
+	{
+		SetError("symbol '%s' not found in '%s'", symbol, module->rfile->name);
+		return KDISASM_ERROR;
+	}
+
+	*start = found->offset;
+	*end = module->rfile->sizeObjectCode;
+
+	node = ListGetHead(module->rfile->refList);
+	while(NULL != node)
+	{
+		Reference *ref;
+
+		ref = NodeGetData(node);
+		if(REF_GLOBAL == ref->type
+			&& 0 != (ref->flag & CODENT)
+			&& ref->offset > found->offset
+			&& ref->offset < *end)
+		{
+			*end = ref->offset;
+		}
+
+		node = NodeGetNext(module->rfile->refList, node);
+	}
+
+	return KDISASM_OK;
+}
+
+
+/*************************************************************************** 
+	Render the code covered by a global symbol
+***************************************************************************/
+int KDisasmRenderSymbol(KDisasmModule *module, const char *symbol, KDisasmBuffer *buffer)
+{
+	unsigned int start;
+	unsigned int end;
+
+	if(KDISASM_OK != KDisasmFindSymbol(module, symbol, &start, &end))
+	{
+		return KDISASM_ERROR;
+	}
+
+	return KDisasmRenderRange(module, start, end, buffer);
+}
+
+
+/*************************************************************************** 
+	Description of the last error on this thread
+***************************************************************************/
+const char *KDisasmGetError(void)
+{
+	return GetErrorText();
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,119 @@
+/*****************************************************************************
+	kdisasm.h	- Public interface to the disassembler library
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	This is the only header an embedding application needs. It does not
+	pull in any of the internal headers so it can be used alongside
+	system headers that define their own BOOL/TRUE/FALSE.
+
+	The trace and render state lives in static tables so the library
+	belongs to one thread at a time. The first thread to load a module
+	owns it until every module is freed, and calls from other threads
+	fail with KDISASM_ERROR until then. Several modules can be loaded at
+	once; switching between them re-traces the module being used.
+
+*****************************************************************************/
+#ifndef KDISASM_H
+#define KDISASM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KDISASM_VERSION		1		/* Bumped when the interface changes */
+
+#define KDISASM_OK			0		/* Call succeeded */
+#define KDISASM_END			-1		/* No more modules or instructions */
+#define KDISASM_ERROR		-2		/* Call failed, see KDisasmGetError() */
+
+#define KDISASM_MAXOPSIZE	5		/* Longest 6809 instruction */
+
+
+typedef struct KDisasmModule KDisasmModule;
+
+typedef struct
+{
+	unsigned int		address;	/* Offset of the line in the code */
+	unsigned int		length;		/* Number of code bytes on the line */
+	int					isCode;		/* Nonzero for an instruction, zero for a data run */
+	const unsigned char	*bytes;		/* Code bytes, owned by the module */
+	const char			*text;		/* Rendered text, valid until the next call */
+	unsigned long		textLength;	/* Length of text */
+} KDisasmInstruction;
+
+/*
+	Growable buffer owned by the caller. Rendering replaces the contents
+	and reuses the memory from earlier renders so redraws do not allocate
+	once the buffer has grown to fit.
+*/
+typedef struct
+{
+	char				*text;		/* Rendered text, null terminated when not NULL */
+	unsigned long		length;		/* Length of text */
+	unsigned long		size;		/* Allocated size of text */
+	unsigned long		*lines;		/* Offset in text of the start of each line */
+	unsigned long		lineCount;	/* Number of lines in text */
+	unsigned long		lineSize;	/* Allocated entries in lines */
+} KDisasmBuffer;
+
+
+int KDisasmLoad(const void *data, unsigned long length, unsigned long *offset, KDisasmModule **module);
+void KDisasmFree(KDisasmModule *module);
+const char *KDisasmGetName(const KDisasmModule *module);
+unsigned int KDisasmGetCodeSize(const KDisasmModule *module);
+
+int KDisasmSetHints(KDisasmModule *module, const char *filename);
+int KDisasmTrace(KDisasmModule *module);
+int KDisasmFirstInstruction(KDisasmModule *module, KDisasmInstruction *insn);
+int KDisasmNextInstruction(KDisasmModule *module, KDisasmInstruction *insn);
+int KDisasmRender(KDisasmModule *module, char *buffer, unsigned long size, unsigned long *length);
+
+void KDisasmBufferInit(KDisasmBuffer *buffer);
+void KDisasmBufferFree(KDisasmBuffer *buffer);
+int KDisasmRenderBuffer(KDisasmModule *module, KDisasmBuffer *buffer);
+int KDisasmRenderRange(KDisasmModule *module, unsigned int start, unsigned int end, KDisasmBuffer *buffer);
+int KDisasmRenderSymbol(KDisasmModule *module, const char *symbol, KDisasmBuffer *buffer);
+int KDisasmFindSymbol(const KDisasmModule *module, const char *symbol, unsigned int *start, unsigned int *end);
+
+const char *KDisasmGetError(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* KDISASM_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,266 @@
+/*****************************************************************************
+	ktest.c	- Checks the listing kept up to date when hints change
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Loads every module of a file through the library and gives it each
+	of the hints files in turn, then no hints at all. After every change
+	the listing that KDisasmSetHints updated in place is compared byte
+	for byte with a listing traced and rendered from scratch with the
+	same hints.
+
+	The first line that differs is printed and the exit status is 1 when
+	any of the listings do not match.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kdisasm.h"
+
+
+static unsigned char *fileData;
+static unsigned long fileLength;
+
+
+
+/*************************************************************************** 
+	Read a whole file into memory
+***************************************************************************/
+static int ReadFile(const char *filename)
+{
+	FILE *in;
+	long length;
+
+	in = fopen(filename, "rb");
+	if(NULL == in)
+	{
+		fprintf(stderr, "ktest: can't open '%s'\n", filename);
+		return -1;
+	}
+
+	fseek(in, 0, SEEK_END);
+	length = ftell(in);
+	fseek(in, 0, SEEK_SET);
+
+	fileData = malloc(length > 0 ? length : 1);
+	if(NULL == fileData || length < 0 || (unsigned long)length != fread(fileData, 1, length, in))
+	{
+		fprintf(stderr, "ktest: can't read '%s'\n", filename);
+		fclose(in);
+		return -1;
+	}
+
+	fileLength = (unsigned long)length;
+	fclose(in);
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Get the text of a line of a render buffer without its newline
+***************************************************************************/
+static const char *GetLine(const KDisasmBuffer *buffer, unsigned long line, int *length)
+{
+	unsigned long start;
+	unsigned long end;
+
+	if(line >= buffer->lineCount)
+	{
+		*length = 5;
+		return "<end>";
+	}
+
+	start = buffer->lines[line];
+	end = line + 1 < buffer->lineCount ? buffer->lines[line + 1] : buffer->length;
+	if(end > start && '\n' == buffer->text[end - 1])
+	{
+		end--;
+	}
+
+	*length = (int)(end - start);
+
+	return buffer->text + start;
+}
+
+
+/*************************************************************************** 
+	Compare the updated listing of a module with the one from scratch
+***************************************************************************/
+static int CompareListings(KDisasmModule *module, const char *hints, const KDisasmBuffer *updated, const KDisasmBuffer *fresh)
+{
+	const char *updatedText;
+	const char *freshText;
+	int updatedLength;
+	int freshLength;
+	unsigned long line;
+
+	if(updated->length == fresh->length
+		&& (0 == fresh->length || 0 == memcmp(updated->text, fresh->text, fresh->length)))
+	{
+		return 0;
+	}
+
+	for(line = 0; line < updated->lineCount || line < fresh->lineCount; line++)
+	{
+		updatedText = GetLine(updated, line, &updatedLength);
+		freshText = GetLine(fresh, line, &freshLength);
+		if(updatedLength != freshLength || 0 != memcmp(updatedText, freshText, freshLength))
+		{
+			break;
+		}
+	}
+
+	updatedText = GetLine(updated, line, &updatedLength);
+	freshText = GetLine(fresh, line, &freshLength);
+
+	fprintf(stderr, "ktest: %s with %s: listings differ at line %lu\n",
+		KDisasmGetName(module),
+		NULL != hints ? hints : "no hints",
+		line + 1);
+	fprintf(stderr, "  updated: %.*s\n", updatedLength, updatedText);
+	fprintf(stderr, "  fresh:   %.*s\n", freshLength, freshText);
+
+	return -1;
+}
+
+
+/*************************************************************************** 
+	Give a module each set of hints in turn and check the listings
+***************************************************************************/
+static int CheckModule(KDisasmModule *module, char **hints, int hintsCount, KDisasmBuffer *updated, KDisasmBuffer *fresh)
+{
+	const char *filename;
+	int failed;
+	int i;
+
+	if(KDISASM_OK != KDisasmTrace(module) || KDISASM_OK != KDisasmRenderBuffer(module, updated))
+	{
+		fprintf(stderr, "ktest: %s: %s\n", KDisasmGetName(module), KDisasmGetError());
+		return -1;
+	}
+
+	failed = 0;
+	for(i = 0; i <= hintsCount; i++)
+	{
+		filename = i < hintsCount ? hints[i] : NULL;
+
+		/* The module is in use so only what the hints reach is redone */
+		if(KDISASM_OK != KDisasmSetHints(module, filename)
+			|| KDISASM_OK != KDisasmRenderBuffer(module, updated))
+		{
+			fprintf(stderr, "ktest: %s: %s\n", KDisasmGetName(module), KDisasmGetError());
+			return -1;
+		}
+
+		if(KDISASM_OK != KDisasmTrace(module) || KDISASM_OK != KDisasmRenderBuffer(module, fresh))
+		{
+			fprintf(stderr, "ktest: %s: %s\n", KDisasmGetName(module), KDisasmGetError());
+			return -1;
+		}
+
+		if(0 != CompareListings(module, filename, updated, fresh))
+		{
+			failed = -1;
+		}
+	}
+
+	return failed;
+}
+
+
+void help(void)
+{
+	fprintf(stderr, "ktest:  checks the listing updated when hints change against\n");
+	fprintf(stderr, "        one made from scratch\n");
+	fprintf(stderr, "usage: ktest <file> <hints> [<hints> ...]\n");
+}
+
+
+int main(int argc, char **argv)
+{
+	KDisasmModule *module;
+	KDisasmBuffer updated;
+	KDisasmBuffer fresh;
+	unsigned long offset;
+	int modules;
+	int failed;
+	int result;
+
+	if(argc < 3 || '-' == argv[1][0])
+	{
+		help();
+		exit(1);
+	}
+
+	if(0 != ReadFile(argv[1]))
+	{
+		exit(1);
+	}
+
+	KDisasmBufferInit(&updated);
+	KDisasmBufferInit(&fresh);
+
+	modules = 0;
+	failed = 0;
+	offset = 0;
+	while(KDISASM_OK == (result = KDisasmLoad(fileData, fileLength, &offset, &module)))
+	{
+		if(0 != CheckModule(module, argv + 2, argc - 2, &updated, &fresh))
+		{
+			failed++;
+		}
+
+		KDisasmFree(module);
+		modules++;
+	}
+
+	if(KDISASM_ERROR == result)
+	{
+		fprintf(stderr, "ktest: %s: %s\n", argv[1], KDisasmGetError());
+		failed++;
+	}
+
+	KDisasmBufferFree(&updated);
+	KDisasmBufferFree(&fresh);
+	free(fileData);
+
+	printf("ktest: %s: %d modules, %d hints files, %d failed\n", argv[1], modules, argc - 2, failed);
+
+	return 0 == failed ? 0 : 1;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -23,29 +23,53 @@ struct _List
 	Node	*head;
 	Node	*tail;
 	u_int32	size;
+	MEMPOOL	pool;	/* Where the list and its nodes are charged */
 };
 
 
-void ListInit(List **listRet)
+void ListInit(List **listRet, MEMPOOL pool)
 {
 	List *list;
 
-	list = malloc(sizeof(List));
+	list = MemAlloc(pool, sizeof(List));
 	if(NULL != list)
 	{
 		list->head = NULL;
 		list->tail = NULL;
 		list->size = 0;
+		list->pool = pool;
 	}
 
 	*listRet = list;
 }
 
+
+/*************************************************************************** 
+	Free a list and its nodes but not the data they hold
+***************************************************************************/
+void ListFree(List *list)
+{
+	Node *node;
+
+	if(NULL == list)
+	{
+		return;
+	}
+
+	while(NULL != (node = list->head))
+	{
+		list->head = node->next;
+		MemFree(node);
+	}
+
+	MemFree(list);
+}
+
 void *ListAddTail(List *list, void *data)
 {
 	Node *node;
 
-	node = malloc(sizeof(Node));
+	node = MemAlloc(list->pool, sizeof(Node));
 	if(NULL != node)
 	{
 		if(NULL == list->head)
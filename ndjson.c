@@ -0,0 +1,237 @@
+/*****************************************************************************
+	ndjson.c	- Newline delimited JSON output of disassembled modules
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Each module produces one "module" record followed by one record for
+	every instruction and every run of data, in address order:
+
+	{"type":"module","name":"...","file":"...","code":n,"data":n,"bss":n}
+	{"type":"insn","address":n,"length":n,"bytes":"hex","label":"..."|null,
+	 "mnemonic":"...","operands":"...","comment":"..."|null,
+	 "ref":{"kind":"...","target":n,"label":"..."}|null}
+	{"type":"data","section":"code"|"data","address":n,"length":n,"bytes":"hex"}
+
+*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "ndjson.h"
+
+#define HEX_CHUNK	64		/* Bytes converted to hex per write */
+
+
+static const char hexDigits[] = "0123456789abcdef";
+
+static const char *refKindNames[] =
+{
+	NULL,
+	"code",
+	"data",
+	"bss",
+	"external",
+	"absolute"
+};
+
+static const char *sectionNames[] =
+{
+	"code",
+	"data"
+};
+
+
+
+/*************************************************************************** 
+	Generate a quoted and escaped JSON string, or null if it is empty
+***************************************************************************/
+static void JsonString(FILE *outFile, const char *text, BOOL nullable)
+{
+	char buffer[2 * 256 + 3];
+	char *out;
+
+	if(TRUE == nullable && 0 == *text)
+	{
+		GenRaw(outFile, "null");
+		return;
+	}
+
+	out = buffer;
+	*out++ = '"';
+	while(0 != *text && out < buffer + sizeof(buffer) - 8)
+	{
+		u_char c;
+
+		c = (u_char)*text++;
+		if('"' == c || '\\' == c)
+		{
+			*out++ = '\\';
+			*out++ = c;
+		}
+		else if('\t' == c)
+		{
+			*out++ = '\\';
+			*out++ = 't';
+		}
+		else if(c < 0x20)
+		{
+			out += sprintf(out, "\\u%04x", c);
+		}
+		else
+		{
+			*out++ = c;
+		}
+	}
+	*out++ = '"';
+	*out = 0;
+
+	GenRaw(outFile, "%s", buffer);
+}
+
+
+/*************************************************************************** 
+	Generate a block of bytes as a quoted hex string
+***************************************************************************/
+static void JsonHex(FILE *outFile, const u_char *bytes, u_int16 length)
+{
+	char buffer[HEX_CHUNK * 2 + 1];
+
+	GenRaw(outFile, "\"");
+	while(0 != length)
+	{
+		u_int16 count;
+		u_int16 i;
+
+		count = length < HEX_CHUNK ? length : HEX_CHUNK;
+		for(i = 0; i < count; i++)
+		{
+			buffer[i * 2] = hexDigits[bytes[i] >> 4];
+			buffer[i * 2 + 1] = hexDigits[bytes[i] & 0x0f];
+		}
+		buffer[count * 2] = 0;
+
+		GenRaw(outFile, "%s", buffer);
+
+		bytes += count;
+		length -= count;
+	}
+	GenRaw(outFile, "\"");
+}
+
+
+/*************************************************************************** 
+	Generate the record that starts a module
+***************************************************************************/
+static void NdjsonModule(RecordSink *sink, FILE *outFile, OS9ROF *rfile)
+{
+	(void)sink;
+
+	GenRaw(outFile, "{\"type\":\"module\",\"name\":");
+	JsonString(outFile, rfile->name, FALSE);
+	GenRaw(outFile, ",\"file\":");
+	JsonString(outFile, rfile->filename, FALSE);
+	GenRaw(outFile,
+		   ",\"code\":%u,\"data\":%u,\"bss\":%u}\n",
+		   rfile->sizeObjectCode,
+		   rfile->sizeInitData,
+		   rfile->sizeUninitData);
+}
+
+
+/*************************************************************************** 
+	Generate the record for a decoded instruction
+***************************************************************************/
+static void NdjsonInstruction(RecordSink *sink, FILE *outFile, const AsmRecord *record, const u_char *bytes)
+{
+	(void)sink;
+
+	GenRaw(outFile, "{\"type\":\"insn\",\"address\":%u,\"length\":%u,\"bytes\":", record->address, record->length);
+	JsonHex(outFile, bytes, record->length);
+	GenRaw(outFile, ",\"label\":");
+	JsonString(outFile, record->label, TRUE);
+	GenRaw(outFile, ",\"mnemonic\":");
+	JsonString(outFile, record->mnemonic, FALSE);
+	GenRaw(outFile, ",\"operands\":");
+	JsonString(outFile, record->operands, FALSE);
+	GenRaw(outFile, ",\"comment\":");
+	JsonString(outFile, record->comment, TRUE);
+	GenRaw(outFile, ",\"ref\":");
+
+	if(ASMREF_NONE == record->refKind)
+	{
+		GenRaw(outFile, "null}\n");
+	}
+	else
+	{
+		GenRaw(outFile, "{\"kind\":\"%s\",\"target\":%u,\"label\":", refKindNames[record->refKind], record->refTarget);
+		JsonString(outFile, record->refLabel, FALSE);
+		GenRaw(outFile, "}}\n");
+	}
+}
+
+
+/*************************************************************************** 
+	Generate the record for a run of data
+***************************************************************************/
+static void NdjsonData(RecordSink *sink, FILE *outFile, int section, const u_char *bytes, u_int16 address, u_int16 length)
+{
+	(void)sink;
+
+	GenRaw(outFile, "{\"type\":\"data\",\"section\":\"%s\",\"address\":%u,\"length\":%u,\"bytes\":", sectionNames[section], address, length);
+	JsonHex(outFile, bytes, length);
+	GenRaw(outFile, "}\n");
+}
+
+
+static void NdjsonEnd(RecordSink *sink, FILE *outFile)
+{
+	(void)sink;
+	(void)outFile;
+}
+
+
+/*************************************************************************** 
+	Set up a sink that generates JSON records
+***************************************************************************/
+void NdjsonSinkInit(RecordSink *sink)
+{
+	sink->module = NdjsonModule;
+	sink->instruction = NdjsonInstruction;
+	sink->data = NdjsonData;
+	sink->end = NdjsonEnd;
+	sink->context = NULL;
+	sink->output = NULL;
+	sink->next = NULL;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
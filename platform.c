@@ -0,0 +1,421 @@
+/*****************************************************************************
+	platform.c	- Operating system specific services
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "platform.h"
+
+struct _Thread
+{
+#ifdef _WIN32
+	HANDLE		handle;
+#else
+	pthread_t	handle;
+#endif
+	THREADPROC	proc;
+	void		*param;
+};
+
+struct _MappedFile
+{
+#ifdef _WIN32
+	HANDLE		file;
+	HANDLE		mapping;
+#endif
+	void		*data;
+	size_t		size;
+};
+
+
+
+/*************************************************************************** 
+	Replace the destination file with a completely written temporary
+	file so readers never see a partially generated listing.
+***************************************************************************/
+int ReplaceFileAtomic(const char *tmpName, const char *destName)
+{
+#ifdef _WIN32
+	if(0 == MoveFileExA(tmpName, destName, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+	{
+		return -1;
+	}
+	return 0;
+#else
+	return rename(tmpName, destName);
+#endif
+}
+
+
+/*************************************************************************** 
+	Millisecond clock used for time budgets
+***************************************************************************/
+unsigned long GetMilliseconds(void)
+{
+#ifdef _WIN32
+	return (unsigned long)GetTickCount64();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+#endif
+}
+
+
+/*************************************************************************** 
+	Microsecond clocks used to time the phases of a module. Only the
+	difference between two readings is meaningful.
+***************************************************************************/
+unsigned long GetMicroseconds(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER count;
+	LARGE_INTEGER frequency;
+
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return (unsigned long)(count.QuadPart / frequency.QuadPart * 1000000
+		+ count.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+#endif
+}
+
+
+unsigned long GetThreadCpuMicroseconds(void)
+{
+#ifdef _WIN32
+	FILETIME created;
+	FILETIME exited;
+	FILETIME kernel;
+	FILETIME user;
+	ULARGE_INTEGER total;
+
+	if(0 == GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user))
+	{
+		return 0;
+	}
+
+	/* The times are in 100 nanosecond units */
+	total.LowPart = kernel.dwLowDateTime;
+	total.HighPart = kernel.dwHighDateTime;
+	total.QuadPart += ((ULONGLONG)user.dwHighDateTime << 32) | user.dwLowDateTime;
+	return (unsigned long)(total.QuadPart / 10);
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (unsigned long)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+#endif
+}
+
+
+/*************************************************************************** 
+	Threads
+***************************************************************************/
+#ifdef _WIN32
+static DWORD WINAPI ThreadEntry(LPVOID param)
+#else
+static void *ThreadEntry(void *param)
+#endif
+{
+	Thread *thread;
+
+	thread = param;
+	thread->proc(thread->param);
+
+	return 0;
+}
+
+
+Thread *ThreadStart(THREADPROC proc, void *param)
+{
+	Thread *thread;
+
+	thread = malloc(sizeof(Thread));
+	if(NULL == thread)
+	{
+		return NULL;
+	}
+
+	thread->proc = proc;
+	thread->param = param;
+
+#ifdef _WIN32
+	thread->handle = CreateThread(NULL, 0, ThreadEntry, thread, 0, NULL);
+	if(NULL == thread->handle)
+#else
+	if(0 != pthread_create(&thread->handle, NULL, ThreadEntry, thread))
+#endif
+	{
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+
+void ThreadJoin(Thread *thread)
+{
+#ifdef _WIN32
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+	free(thread);
+}
+
+
+void ThreadYield(void)
+{
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
+
+void ThreadSleep(unsigned long milliseconds)
+{
+#ifdef _WIN32
+	Sleep(milliseconds);
+#else
+	struct timespec ts;
+
+	ts.tv_sec = milliseconds / 1000;
+	ts.tv_nsec = (milliseconds % 1000) * 1000000;
+	nanosleep(&ts, NULL);
+#endif
+}
+
+
+/*************************************************************************** 
+	Atomic access with acquire on load and release on store
+***************************************************************************/
+long AtomicLoad(volatile long *value)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange(value, 0, 0);
+#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+
+void AtomicStore(volatile long *value, long newValue)
+{
+#ifdef _WIN32
+	InterlockedExchange(value, newValue);
+#else
+	__atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+#endif
+}
+
+
+/*************************************************************************** 
+	Atomic read-modify-write with full ordering. AtomicAdd returns the new
+	value.
+***************************************************************************/
+long AtomicAdd(volatile long *value, long amount)
+{
+#ifdef _WIN32
+	return InterlockedExchangeAdd(value, amount) + amount;
+#else
+	return __atomic_add_fetch(value, amount, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/*************************************************************************** 
+	Set value to newValue if it holds expected. Returns the value it held.
+***************************************************************************/
+long AtomicCompareExchange(volatile long *value, long expected, long newValue)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange(value, newValue, expected);
+#else
+	__atomic_compare_exchange_n(value, &expected, newValue, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return expected;
+#endif
+}
+
+
+/*************************************************************************** 
+	Raise value to candidate if candidate is larger
+***************************************************************************/
+void AtomicMax(volatile long *value, long candidate)
+{
+	long current;
+
+	current = AtomicLoad(value);
+	while(candidate > current)
+	{
+#ifdef _WIN32
+		long previous;
+
+		previous = InterlockedCompareExchange(value, candidate, current);
+		if(previous == current)
+		{
+			break;
+		}
+		current = previous;
+#else
+		if(__atomic_compare_exchange_n(value, &current, candidate, 0, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE))
+		{
+			break;
+		}
+#endif
+	}
+}
+
+
+/*************************************************************************** 
+	Map a file read only into memory. Returns NULL if the file can not
+	be opened or is empty.
+***************************************************************************/
+MappedFile *MapFile(const char *filename, const void **data, unsigned long *size)
+{
+	MappedFile *mapping;
+
+	mapping = calloc(1, sizeof(MappedFile));
+	if(NULL == mapping)
+	{
+		return NULL;
+	}
+
+#ifdef _WIN32
+	{
+		LARGE_INTEGER fileSize;
+
+		mapping->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if(INVALID_HANDLE_VALUE == mapping->file)
+		{
+			free(mapping);
+			return NULL;
+		}
+
+		if(0 == GetFileSizeEx(mapping->file, &fileSize) || 0 == fileSize.QuadPart || fileSize.QuadPart > 0x7fffffff)
+		{
+			CloseHandle(mapping->file);
+			free(mapping);
+			return NULL;
+		}
+		mapping->size = (size_t)fileSize.QuadPart;
+
+		mapping->mapping = CreateFileMappingA(mapping->file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if(NULL == mapping->mapping)
+		{
+			CloseHandle(mapping->file);
+			free(mapping);
+			return NULL;
+		}
+
+		mapping->data = MapViewOfFile(mapping->mapping, FILE_MAP_READ, 0, 0, 0);
+		if(NULL == mapping->data)
+		{
+			CloseHandle(mapping->mapping);
+			CloseHandle(mapping->file);
+			free(mapping);
+			return NULL;
+		}
+	}
+#else
+	{
+		struct stat info;
+		int fd;
+
+		fd = open(filename, O_RDONLY);
+		if(fd < 0)
+		{
+			free(mapping);
+			return NULL;
+		}
+
+		if(0 != fstat(fd, &info) || 0 == info.st_size)
+		{
+			close(fd);
+			free(mapping);
+			return NULL;
+		}
+		mapping->size = (size_t)info.st_size;
+
+		mapping->data = mmap(NULL, mapping->size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if(MAP_FAILED == mapping->data)
+		{
+			free(mapping);
+			return NULL;
+		}
+	}
+#endif
+
+	*data = mapping->data;
+	*size = (unsigned long)mapping->size;
+
+	return mapping;
+}
+
+
+void UnmapFile(MappedFile *mapping)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(mapping->data);
+	CloseHandle(mapping->mapping);
+	CloseHandle(mapping->file);
+#else
+	munmap(mapping->data, mapping->size);
+#endif
+	free(mapping);
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,71 @@
+/*****************************************************************************
+	platform.h	- Operating system specific services
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	This header must not depend on util.h. The Windows headers define
+	their own BOOL, TRUE, and FALSE so the implementation is kept away
+	from the rest of the disassembler.
+
+*****************************************************************************/
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+typedef struct _Thread Thread;
+typedef struct _MappedFile MappedFile;
+typedef void (*THREADPROC)(void *param);
+
+int ReplaceFileAtomic(const char *tmpName, const char *destName);
+unsigned long GetMilliseconds(void);
+unsigned long GetMicroseconds(void);
+unsigned long GetThreadCpuMicroseconds(void);
+
+Thread *ThreadStart(THREADPROC proc, void *param);
+void ThreadJoin(Thread *thread);
+void ThreadYield(void);
+void ThreadSleep(unsigned long milliseconds);
+
+long AtomicLoad(volatile long *value);
+void AtomicStore(volatile long *value, long newValue);
+long AtomicAdd(volatile long *value, long amount);
+long AtomicCompareExchange(volatile long *value, long expected, long newValue);
+void AtomicMax(volatile long *value, long candidate);
+
+MappedFile *MapFile(const char *filename, const void **data, unsigned long *size);
+void UnmapFile(MappedFile *mapping);
+
+#endif	/* PLATFORM_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
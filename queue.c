@@ -0,0 +1,149 @@
+/*****************************************************************************
+	queue.c	- Bounded single producer/single consumer queue
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	The queue is lock free. The producer owns the tail and the consumer
+	owns the head so each index only ever has a single writer. A full or
+	empty queue spins briefly and then backs off to sleeping since the
+	other side is usually waiting on I/O.
+
+*****************************************************************************/
+#include <stdlib.h>
+#include "queue.h"
+#include "platform.h"
+
+#define QUEUE_SPINS		64		/* Yields before the waiting side starts to sleep */
+
+
+
+/*************************************************************************** 
+***************************************************************************/
+static void QueueWait(int *spins)
+{
+	if(*spins < QUEUE_SPINS)
+	{
+		(*spins)++;
+		ThreadYield();
+	}
+	else
+	{
+		ThreadSleep(1);
+	}
+}
+
+
+/*************************************************************************** 
+***************************************************************************/
+Queue *QueueCreate(long capacity)
+{
+	Queue *queue;
+
+	queue = malloc(sizeof(Queue));
+	if(NULL == queue)
+	{
+		return NULL;
+	}
+
+	/* One slot is kept empty to tell a full ring from an empty one */
+	queue->capacity = capacity + 1;
+	queue->items = calloc(queue->capacity, sizeof(void *));
+	queue->head = 0;
+	queue->tail = 0;
+
+	if(NULL == queue->items)
+	{
+		free(queue);
+		return NULL;
+	}
+
+	return queue;
+}
+
+
+void QueueFree(Queue *queue)
+{
+	free(queue->items);
+	free(queue);
+}
+
+
+/*************************************************************************** 
+	Add an item, waiting while the queue is full
+***************************************************************************/
+void QueuePush(Queue *queue, void *item)
+{
+	long tail;
+	long next;
+	int spins;
+
+	tail = queue->tail;
+	next = (tail + 1) % queue->capacity;
+
+	spins = 0;
+	while(next == AtomicLoad(&queue->head))
+	{
+		QueueWait(&spins);
+	}
+
+	queue->items[tail] = item;
+	AtomicStore(&queue->tail, next);
+}
+
+
+/*************************************************************************** 
+	Remove an item, waiting while the queue is empty
+***************************************************************************/
+void *QueuePop(Queue *queue)
+{
+	long head;
+	void *item;
+	int spins;
+
+	head = queue->head;
+
+	spins = 0;
+	while(head == AtomicLoad(&queue->tail))
+	{
+		QueueWait(&spins);
+	}
+
+	item = queue->items[head];
+	AtomicStore(&queue->head, (head + 1) % queue->capacity);
+
+	return item;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -12,103 +12,1067 @@
 #include <memory.h>
 #include <string.h>
 #include <io.h>
+#include <time.h>
+#include <sys/stat.h>
 #include "rof.h"
 #include "disasm.h"
+#include "watch.h"
+#include "journal.h"
+#include "platform.h"
+#include "queue.h"
+#include "genasm.h"
+#include "ndjson.h"
+#include "kdbwrite.h"
+#include "xref.h"
+#include "stats.h"
+#include "hexfmt.h"
 
 #define MAXSOURCE	20
+#define PIPELINE_DEPTH	8		/* Modules buffered between pipeline stages */
+
+/* Outputs that one disassembly pass can generate */
+enum
+{
+	OUTPUT_ASM,			/* Assembly listing */
+	OUTPUT_ROF,			/* ROF header and reference dump */
+	OUTPUT_NDJSON,		/* JSON records */
+	OUTPUT_XREF,		/* Cross reference table */
+	OUTPUT_KDB,			/* Binary disassembly, one file per source */
+	OUTPUT_COUNT
+};
+
+typedef struct
+{
+	char		name[256];		/* Name of the module */
+	u_int32		checksum;		/* Checksum of the module bytes */
+} ModuleStamp;
+
+typedef struct
+{
+	time_t		modified;		/* Modification time of the source file */
+	long		size;			/* Size of the source file */
+	List		*modules;		/* Modules last seen in the file */
+} SourceStamp;
+
+typedef struct
+{
+	const char	*source;		/* Source file containing the module */
+	u_int32		offset;			/* Offset of the module in the source */
+	char		name[256];		/* Name of the module if known */
+	char		reason[256];	/* Why the module failed */
+} ModuleFailure;
+
+typedef struct
+{
+	OS9ROF		*rfile;			/* Loaded module, NULL once rendered or if it failed to load */
+	const char	*source;		/* Source file containing the module */
+	u_int32		offset;			/* Offset of the module in the source */
+	u_int32		checksum;		/* Checksum of the module bytes */
+	char		name[256];		/* Name of the module */
+	int			result;			/* Result of loading and disassembling */
+	char		error[256];		/* Why the module failed */
+	TextBuf		output[OUTPUT_COUNT];	/* Rendered outputs */
+	PhaseStats	stats;			/* Timing and counters of the module */
+} WorkItem;
+
+typedef struct
+{
+	u_int32		opcode;			/* Page in the high byte and the opcode in the low */
+	u_int32		count;			/* Times the opcode was decoded */
+} HistogramEntry;
+
 static const char *snames[MAXSOURCE];
-static const char *fname = NULL;
 static int16 scount = 0;
 static BOOL gflag = FALSE;
 static BOOL rflag = FALSE;
 static BOOL oflag = FALSE;
 static BOOL iflag = FALSE;
-static FILE *in = NULL;
+static BOOL watchflag = FALSE;
+static BOOL sweepflag = FALSE;
+static BOOL histflag = FALSE;
+static BOOL emit[OUTPUT_COUNT] = {TRUE, FALSE, FALSE, FALSE, FALSE};
+static int primaryOutput = OUTPUT_ASM;	/* Output the journal tracks */
+static const char *outputNames[OUTPUT_COUNT] = {"asm", "rof", "ndjson", "xref", "kdb"};
+static const char *outputExts[OUTPUT_COUNT] = {".asm", ".rof", ".ndjson", ".xref", ".kdb"};
+static const char *journalName = NULL;
+static const char *hintsName = NULL;
+static Hints *hints = NULL;
+static SourceStamp sstamps[MAXSOURCE];
+static BOOL spending[MAXSOURCE];
+static BOOL incremental = FALSE;
+static Queue *loadQueue = NULL;
+static Queue *writeQueue = NULL;
+static List *failures = NULL;
+static ModuleLimits limits;
+static const char *kdbSource = NULL;	/* Source the collected chunks belong to */
+static TextBuf *kdbChunks = NULL;		/* Binary chunks of the modules in the source */
+static u_int32 kdbCount = 0;
+static u_int32 kdbSize = 0;
+static SweepStats sweepStats;			/* Opcode counts for --histogram */
+static BOOL statsflag = FALSE;			/* Print the stats of each module */
+static BOOL collectStats = FALSE;		/* Set when the stats are printed or written */
+static const char *statsJsonName = NULL;
+static FILE *statsJson = NULL;			/* JSON records of the stats */
+static const char *timelineName = NULL;	/* Chrome trace events of the threads */
+static PhaseStats batchStats;			/* Stats of the modules of one run */
+static u_int32 batchModules = 0;
+
+
+
+/*
+	header
+	globals
+	object code
+	dp data
+	data
+	external references
+	local references
+*/
+static const char *GetOutputName(OS9ROF *rfile, char *outName)
+{
+	if(FALSE == iflag)
+	{
+		return NULL;
+	}
+
+	strcpy(outName, rfile->name);
+	strcat(outName, outputExts[primaryOutput]);
+
+	return outName;
+}
+
+
+/*************************************************************************** 
+	Record a module that could not be disassembled
+***************************************************************************/
+static void RecordFailure(const char *source, u_int32 offset, const char *name, const char *reason)
+{
+	ModuleFailure *failure;
+
+	fprintf(stderr, "kdisasm: %s: module %s at $%lx failed: %s\n", source, name, (unsigned long)offset, reason);
+
+	failure = MemAlloc(MEM_OTHER, sizeof(ModuleFailure));
+	if(NULL != failure)
+	{
+		failure->source = source;
+		failure->offset = offset;
+		strncpy(failure->name, name, sizeof(failure->name) - 1);
+		strncpy(failure->reason, reason, sizeof(failure->reason) - 1);
+		ListAddTail(failures, failure);
+	}
+}
+
+
+/*************************************************************************** 
+	Print the modules that failed. Returns the number of failures.
+***************************************************************************/
+static u_int32 PrintFailures(void)
+{
+	Node *node;
+	u_int32 count;
+
+	count = ListGetSize(failures);
+	if(0 == count)
+	{
+		return 0;
+	}
+
+	fprintf(stderr, "kdisasm: %lu module(s) failed:\n", (unsigned long)count);
+
+	node = ListGetHead(failures);
+	while(NULL != node)
+	{
+		ModuleFailure *failure;
+
+		failure = NodeGetData(node);
+		fprintf(stderr, "  %s: %s at $%lx: %s\n", failure->source, failure->name, (unsigned long)failure->offset, failure->reason);
+
+		node = NodeGetNext(failures, node);
+	}
+
+	return count;
+}
+
+
+/*************************************************************************** 
+	Allocate a work item for a module or a failure to load one
+***************************************************************************/
+static WorkItem *CreateWorkItem(const char *source, u_int32 offset, OS9ROF *rfile)
+{
+	WorkItem *item;
+	int index;
+
+	item = MemAlloc(MEM_OTHER, sizeof(WorkItem));
+	if(NULL == item)
+	{
+		error("out of memory");
+	}
+
+	item->rfile = rfile;
+	item->source = source;
+	item->offset = offset;
+	strcpy(item->name, NULL != rfile ? rfile->name : "?");
+	for(index = 0; index < OUTPUT_COUNT; index++)
+	{
+		TextBufInit(&item->output[index]);
+	}
+
+	return item;
+}
+
+
+static void FreeWorkItem(WorkItem *item)
+{
+	int index;
+
+	if(NULL != item->rfile)
+	{
+		FreeROF(item->rfile);
+	}
+	for(index = 0; index < OUTPUT_COUNT; index++)
+	{
+		TextBufFree(&item->output[index]);
+	}
+	MemFree(item);
+}
+
+
+static void FailWorkItem(WorkItem *item, const char *reason)
+{
+	item->result = -1;
+	strncpy(item->error, reason, sizeof(item->error) - 1);
+}
+
+
+/*************************************************************************** 
+	Find the last known checksum of a module in a source file
+***************************************************************************/
+static ModuleStamp *FindModuleStamp(SourceStamp *source, const char *name)
+{
+	Node *node;
+
+	node = ListGetHead(source->modules);
+	while(NULL != node)
+	{
+		ModuleStamp *stamp;
+
+		stamp = NodeGetData(node);
+		if(0 == strcmp(stamp->name, name))
+		{
+			return stamp;
+		}
+
+		node = NodeGetNext(source->modules, node);
+	}
+
+	return NULL;
+}
+
+
+/*************************************************************************** 
+	Check if modules finished before can be skipped. Outputs that cover
+	every module of a run can't leave any out.
+***************************************************************************/
+static BOOL CanSkipModules(void)
+{
+	return FALSE == emit[OUTPUT_KDB] && FALSE == histflag ? TRUE : FALSE;
+}
+
+
+/*************************************************************************** 
+	Read all modules in a source file and queue the ones that need to be
+	disassembled. When incremental is set only modules whose bytes have
+	changed since the last pass are queued.
+***************************************************************************/
+static void ReadSource(int16 index, BOOL incremental)
+{
+	SourceStamp *source;
+	const char *fname;
+	FILE *in;
+	int rofCount;
+
+	fname = snames[index];
+	source = &sstamps[index];
+
+	in = fopen(fname,"rb");
+
+	if(in == NULL)
+	{
+		WorkItem *item;
+
+		item = CreateWorkItem(fname, 0, NULL);
+		strcpy(item->name, "-");
+		FailWorkItem(item, "can't open file");
+		QueuePush(loadQueue, item);
+		return;
+	}
+
+	rofCount = 0;
+	while(TRUE)
+	{
+		OS9ROF *rfile;
+		ModuleStamp *stamp;
+		PhaseStats stats;
+		WorkItem *item;
+		u_int32 checksum;
+		u_int32 offset;
+		char outName[264];
+		fpos_t start;
+		int result;
+
+		fgetpos(in, &start);
+
+		memset(&stats, 0, sizeof(stats));
+		StatsAttach(TRUE == collectStats ? &stats : NULL);
+		StatsEnter(PHASE_LOAD);
+		result = LoadROF(in, &rfile, fname);
+		StatsLeave();
+		StatsAttach(NULL);
+
+		if(ROF_ERROR == result)
+		{
+			/* Skip the broken module and try to find the next one */
+			item = CreateWorkItem(fname, (u_int32)start, NULL);
+			if(0 != *GetFailedROFName())
+			{
+				strcpy(item->name, GetFailedROFName());
+			}
+			item->stats = stats;
+			FailWorkItem(item, GetErrorText());
+			QueuePush(loadQueue, item);
+			rofCount++;
+
+			if(ROF_OK != SkipToNextROF(in, start))
+			{
+				break;
+			}
+			continue;
+		}
+
+		if(ROF_OK != result)
+		{
+			if(0 == rofCount)
+			{
+				item = CreateWorkItem(fname, 0, NULL);
+				strcpy(item->name, "-");
+				FailWorkItem(item, "does not contain any relocatable object files");
+				QueuePush(loadQueue, item);
+			}
+
+			break;
+		}
+
+		rofCount++;
+
+		checksum = GetROFChecksum(in, rfile);
+		stamp = FindModuleStamp(source, rfile->name);
+		offset = (u_int32)rfile->offsetBase;
+
+		/* A .kdb file holds every module of the source so none can be skipped */
+		if(TRUE == CanSkipModules() && FALSE == incremental && TRUE == JournalIsComplete(fname, offset, checksum, GetOutputName(rfile, outName)))
+		{
+			fprintf(stderr, "Skipping %s (completed)\n", rfile->name);
+			FreeROF(rfile);
+			continue;
+		}
+
+		if(TRUE == CanSkipModules() && TRUE == incremental && NULL != stamp && stamp->checksum == checksum)
+		{
+			FreeROF(rfile);
+			continue;
+		}
+
+		if(NULL == stamp)
+		{
+			stamp = MemAlloc(MEM_OTHER, sizeof(ModuleStamp));
+			strcpy(stamp->name, rfile->name);
+			ListAddTail(source->modules, stamp);
+		}
+		stamp->checksum = checksum;
+
+		item = CreateWorkItem(fname, offset, rfile);
+		item->checksum = checksum;
+		item->stats = stats;
+		QueuePush(loadQueue, item);
+	}
+	fclose(in);
+}
+
+
+/*************************************************************************** 
+	Reader stage - loads modules from the pending source files
+***************************************************************************/
+static void ReaderStage(void *param)
+{
+	int16 count;
+
+	(void)param;
+	TimelineThreadName("reader");
+
+	for(count = 0; count < scount; count++)
+	{
+		if(TRUE == spending[count])
+		{
+			spending[count] = FALSE;
+			ReadSource(count, incremental);
+		}
+	}
+
+	QueuePush(loadQueue, NULL);
+}
+
+
+/*************************************************************************** 
+	Render every requested output of a traced module from one pass. The
+	listing is generated while the sinks for the other outputs receive
+	the same lines.
+***************************************************************************/
+static int RenderModule(WorkItem *item, OS9ROF *rfile)
+{
+	RecordSink sinks[OUTPUT_COUNT];
+	RecordSink *chain;
+	KdbWriter writer;
+	XrefTable table;
+	int result;
+
+	/* The ROF dump leads the listing unless it has an output of its own */
+	if(TRUE == emit[OUTPUT_ROF] || (TRUE == rflag && TRUE == emit[OUTPUT_ASM]))
+	{
+		SetAsmOutputBuffer(&item->output[TRUE == emit[OUTPUT_ROF] ? OUTPUT_ROF : OUTPUT_ASM]);
+		DumpROFInfo(NULL, rfile);
+	}
+
+	chain = NULL;
+	if(TRUE == emit[OUTPUT_KDB])
+	{
+		KdbSinkInit(&sinks[OUTPUT_KDB], &writer);
+		sinks[OUTPUT_KDB].output = &item->output[OUTPUT_KDB];
+		sinks[OUTPUT_KDB].next = chain;
+		chain = &sinks[OUTPUT_KDB];
+	}
+	if(TRUE == emit[OUTPUT_XREF])
+	{
+		XrefSinkInit(&sinks[OUTPUT_XREF], &table);
+		sinks[OUTPUT_XREF].output = &item->output[OUTPUT_XREF];
+		sinks[OUTPUT_XREF].next = chain;
+		chain = &sinks[OUTPUT_XREF];
+	}
+	if(TRUE == emit[OUTPUT_NDJSON])
+	{
+		NdjsonSinkInit(&sinks[OUTPUT_NDJSON]);
+		sinks[OUTPUT_NDJSON].output = &item->output[OUTPUT_NDJSON];
+		sinks[OUTPUT_NDJSON].next = chain;
+		chain = &sinks[OUTPUT_NDJSON];
+	}
+
+	SetAsmOutputBuffer(&item->output[OUTPUT_ASM]);
+	SetRecordSink(chain);
+	SetAsmRecordListing(emit[OUTPUT_ASM]);
+	if(TRUE == sweepflag)
+	{
+		result = DisasmSweepCode(NULL, rfile);
+	}
+	else
+	{
+		result = DisasmObjectCode(NULL, rfile);
+	}
+	SetAsmRecordListing(FALSE);
+	SetRecordSink(NULL);
+	SetAsmOutputBuffer(NULL);
+
+	if(TRUE == emit[OUTPUT_KDB])
+	{
+		if(0 == result && TRUE == KdbWriterFailed(&writer))
+		{
+			SetError("out of memory");
+			result = -1;
+		}
+		KdbWriterFree(&writer);
+	}
+	if(TRUE == emit[OUTPUT_XREF])
+	{
+		XrefTableFree(&table);
+	}
+
+	return result;
+}
+
+
+/*************************************************************************** 
+	Count the lines and bytes of the rendered outputs of a module
+***************************************************************************/
+static void CountOutput(WorkItem *item)
+{
+	int output;
+
+	for(output = 0; output < OUTPUT_COUNT; output++)
+	{
+		const char *text;
+		const char *end;
+
+		STATS_COUNT(STAT_BYTES, item->output[output].length);
+
+		/* The binary output has no lines */
+		if(OUTPUT_KDB == output || 0 == item->output[output].length)
+		{
+			continue;
+		}
+
+		text = item->output[output].text;
+		end = text + item->output[output].length;
+		while(NULL != (text = memchr(text, '\n', end - text)))
+		{
+			STATS_COUNT(STAT_LINES, 1);
+			text++;
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Disassembly stage - traces modules and renders them to memory
+***************************************************************************/
+static void DisasmStage(void *param)
+{
+	WorkItem *item;
+
+	(void)param;
+	TimelineThreadName("disassembler");
+
+	while(NULL != (item = QueuePop(loadQueue)))
+	{
+		if(0 == item->result)
+		{
+			OS9ROF *rfile;
+
+			rfile = item->rfile;
+			fprintf(stderr, "Disassembling %s\n", rfile->name);
+			TimelineBegin(rfile->name);
+
+			StatsAttach(TRUE == collectStats ? &item->stats : NULL);
+
+			if(TRUE == histflag)
+			{
+				item->result = SweepStatistics(rfile, &sweepStats);
+			}
+			else
+			{
+				if(TRUE == sweepflag)
+				{
+					item->result = SweepObjectCode(rfile);
+				}
+				else
+				{
+					item->result = TraceObjectCode(rfile);
+				}
+
+				if(0 == item->result)
+				{
+					TimelineBegin("render");
+					item->result = RenderModule(item, rfile);
+					TimelineEnd();
+				}
+			}
+
+			CountOutput(item);
+			TimelineEnd();
+
+			if(0 != item->result)
+			{
+				FailWorkItem(item, GetErrorText());
+			}
+
+			/*
+				The writer only needs the text. The module is freed before
+				the stats are detached so the memory it gives back counts.
+			*/
+			FreeROF(rfile);
+			item->rfile = NULL;
+			StatsAttach(NULL);
+		}
+
+		QueuePush(writeQueue, item);
+	}
+
+	QueuePush(writeQueue, NULL);
+}
+
+
+/*************************************************************************** 
+	Write the collected chunks of a source file to <source>.kdb
+***************************************************************************/
+static void FlushKdb(void)
+{
+	FILE *outFile;
+	char outName[260];
+	char tmpName[264];
+	char reason[300];
+	u_int32 index;
+	int result;
+
+	/*
+		The .kdb file belongs to the whole source rather than to one of
+		its modules so failures are recorded against the source the same
+		way an unreadable source is.
+	*/
+	if(0 != kdbCount)
+	{
+		sprintf(outName, "%.250s.kdb", kdbSource);
+		strcpy(tmpName, outName);
+		strcat(tmpName, ".tmp");
+
+		outFile = fopen(tmpName, "wb");
+		if(NULL == outFile)
+		{
+			sprintf(reason, "can't create '%s'", tmpName);
+			RecordFailure(kdbSource, 0, "-", reason);
+		}
+		else
+		{
+			result = KdbAssemble(outFile, kdbChunks, kdbCount);
+			fclose(outFile);
+
+			if(0 != result)
+			{
+				remove(tmpName);
+				RecordFailure(kdbSource, 0, "-", GetErrorText());
+			}
+			else if(0 != ReplaceFileAtomic(tmpName, outName))
+			{
+				sprintf(reason, "can't replace '%s'", outName);
+				RecordFailure(kdbSource, 0, "-", reason);
+			}
+		}
+	}
+
+	for(index = 0; index < kdbCount; index++)
+	{
+		TextBufFree(&kdbChunks[index]);
+	}
+	kdbCount = 0;
+	kdbSource = NULL;
+}
+
+
+/*************************************************************************** 
+	Keep the chunk of a module until every module of its source is done.
+	Modules arrive grouped by source.
+***************************************************************************/
+static void CollectKdb(WorkItem *item)
+{
+	if(item->source != kdbSource)
+	{
+		FlushKdb();
+		kdbSource = item->source;
+	}
+
+	if(kdbCount == kdbSize)
+	{
+		TextBuf *chunks;
+		u_int32 size;
+
+		size = 0 != kdbSize ? kdbSize * 2 : 16;
+		chunks = MemRealloc(MEM_OUTPUT, kdbChunks, size * sizeof(TextBuf));
+		if(NULL == chunks)
+		{
+			error("out of memory");
+		}
+		kdbChunks = chunks;
+		kdbSize = size;
+	}
+
+	/* Take over the rendered chunk */
+	kdbChunks[kdbCount++] = item->output[OUTPUT_KDB];
+	TextBufInit(&item->output[OUTPUT_KDB]);
+}
+
+
+/*************************************************************************** 
+	Write one output of a module to its file, or to stdout when not
+	writing files.
+***************************************************************************/
+static int WriteOutput(WorkItem *item, int output, u_int32 *outHash)
+{
+	FILE *outFile;
+	char outName[264];
+	char tmpName[268];
+
+	if(FALSE == iflag)
+	{
+		fwrite(item->output[output].text, 1, item->output[output].length, stdout);
+		return 0;
+	}
+
+	/* Write to a temporary file and swap it in when complete */
+	strcpy(outName, item->name);
+	strcat(outName, outputExts[output]);
+	strcpy(tmpName, outName);
+	strcat(tmpName, ".tmp");
+
+	outFile = fopen(tmpName, "w");
+	if(NULL == outFile)
+	{
+		sprintf(item->error, "can't create '%.200s'", tmpName);
+		RecordFailure(item->source, item->offset, item->name, item->error);
+		return -1;
+	}
+
+	fwrite(item->output[output].text, 1, item->output[output].length, outFile);
+	if(0 != ferror(outFile))
+	{
+		fclose(outFile);
+		remove(tmpName);
+		RecordFailure(item->source, item->offset, item->name, "error writing output");
+		return -1;
+	}
+	fclose(outFile);
+
+	*outHash = HashFile(tmpName);
+	if(0 != ReplaceFileAtomic(tmpName, outName))
+	{
+		sprintf(item->error, "can't replace '%.200s'", outName);
+		RecordFailure(item->source, item->offset, item->name, item->error);
+		return -1;
+	}
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Writer stage - writes the rendered outputs and records progress
+***************************************************************************/
+static void WriteModule(WorkItem *item)
+{
+	u_int32 outHash;
+	u_int32 hash;
+	int output;
+
+	if(0 != item->result)
+	{
+		RecordFailure(item->source, item->offset, item->name, item->error);
+		return;
+	}
+
+	/* The histogram is printed once every module has been counted */
+	if(TRUE == histflag)
+	{
+		return;
+	}
+
+	outHash = 0;
+	for(output = 0; output < OUTPUT_COUNT; output++)
+	{
+		if(FALSE == emit[output])
+		{
+			continue;
+		}
+
+		if(OUTPUT_KDB == output)
+		{
+			CollectKdb(item);
+			continue;
+		}
+
+		hash = 0;
+		if(0 != WriteOutput(item, output, &hash))
+		{
+			return;
+		}
+
+		/* The journal checks the first output when resuming */
+		if(primaryOutput == output)
+		{
+			outHash = hash;
+		}
+	}
+
+	JournalRecord(item->source, item->offset, item->checksum, outHash);
+}
+
+
+/*************************************************************************** 
+	Report the stats of a module and add them to the batch
+***************************************************************************/
+static void ReportStats(WorkItem *item)
+{
+	char title[300];
+
+	if(TRUE == statsflag)
+	{
+		sprintf(title, "%.200s (%.40s at %lu)", item->name, item->source, (unsigned long)item->offset);
+		StatsPrint(stderr, title, &item->stats);
+	}
+
+	if(NULL != statsJson)
+	{
+		StatsPrintJson(statsJson, "module", item->source, item->name, &item->stats);
+	}
+
+	StatsAdd(&batchStats, &item->stats);
+	batchModules++;
+}
+
+
+/*************************************************************************** 
+	Report the total of the modules of a run
+***************************************************************************/
+static void ReportBatchStats(void)
+{
+	char title[64];
+
+	/*
+		The memory of the run is that of the whole process so its peak
+		covers the modules that were in flight at the same time
+	*/
+	MemGetTotals(batchStats.memory);
+
+	if(TRUE == statsflag)
+	{
+		sprintf(title, "Total of %lu modules", (unsigned long)batchModules);
+		StatsPrint(stderr, title, &batchStats);
+	}
+
+	if(NULL != statsJson)
+	{
+		StatsPrintJson(statsJson, "batch", NULL, NULL, &batchStats);
+		fflush(statsJson);
+	}
+}
+
+
+/*************************************************************************** 
+	Compare histogram entries by descending count
+***************************************************************************/
+static int CompareCounts(const void *a, const void *b)
+{
+	const HistogramEntry *left;
+	const HistogramEntry *right;
 
+	left = a;
+	right = b;
 
+	if(left->count != right->count)
+	{
+		return left->count < right->count ? 1 : -1;
+	}
 
-/*
-	header
-	globals
-	object code
-	dp data
-	data
-	external references
-	local references
-*/
-void DisassembleROF()
+	return left->opcode < right->opcode ? -1 : left->opcode > right->opcode;
+}
+
+
+/*************************************************************************** 
+	Print the opcode counts of a sweep, most frequent first
+***************************************************************************/
+static void PrintHistogram(const SweepStats *stats)
 {
-	int16 count;
+	static HistogramEntry entries[3 * 256];
+	static const char prefix[3][3] = {"", "10", "11"};
+	Opcode *tables[3];
+	u_int32 count;
+	u_int32 i;
 
-	if(scount == 0)
+	tables[0] = optable;
+	tables[1] = optable10;
+	tables[2] = optable11;
+
+	count = 0;
+	for(i = 0; i < 3 * 256; i++)
 	{
-		return;
+		if(0 != stats->opcodes[i >> 8][i & 0xff])
+		{
+			entries[count].opcode = i;
+			entries[count].count = stats->opcodes[i >> 8][i & 0xff];
+			count++;
+		}
 	}
 
-	for(count = 0; count < scount; count++)
+	qsort(entries, count, sizeof(entries[0]), CompareCounts);
+
+	printf("modules       %lu\n", (unsigned long)stats->modules);
+	printf("instructions  %lu\n", (unsigned long)stats->instructions);
+	printf("bytes         %lu\n", (unsigned long)stats->bytes);
+	printf("trailing      %lu\n", (unsigned long)stats->trailing);
+	printf("\n");
+
+	for(i = 0; i < count; i++)
+	{
+		u_int32 page;
+		u_int32 code;
+		const char *name;
+		char value[8];
+
+		page = entries[i].opcode >> 8;
+		code = entries[i].opcode & 0xff;
+		name = tables[page][code].opName;
+
+		sprintf(value, "%s%02lX", prefix[page], (unsigned long)code);
+		printf("%-6s%-8s%10lu %6.2f%%\n",
+			value,
+			NULL != name ? name : "illegal",
+			(unsigned long)entries[i].count,
+			100.0 * entries[i].count / stats->instructions);
+	}
+}
+
+
+/*************************************************************************** 
+	Run the pending source files through the read, disassemble, and
+	write stages. The writer runs on the calling thread.
+***************************************************************************/
+static void RunPipeline(BOOL incrementalRun)
+{
+	Thread *reader;
+	Thread *disasm;
+	WorkItem *item;
+
+	incremental = incrementalRun;
+	memset(&sweepStats, 0, sizeof(sweepStats));
+	memset(&batchStats, 0, sizeof(batchStats));
+	batchModules = 0;
+
+	loadQueue = QueueCreate(PIPELINE_DEPTH);
+	writeQueue = QueueCreate(PIPELINE_DEPTH);
+	if(NULL == loadQueue || NULL == writeQueue)
+	{
+		error("out of memory");
+	}
+
+	reader = ThreadStart(ReaderStage, NULL);
+	disasm = ThreadStart(DisasmStage, NULL);
+	if(NULL == reader || NULL == disasm)
 	{
-		int rofCount;
+		error("unable to start pipeline threads");
+	}
 
-		fname = snames[count];
+	TimelineThreadName("writer");
 
-		in = fopen(fname,"rb");
+	while(NULL != (item = QueuePop(writeQueue)))
+	{
+		TimelineBegin("write");
+		WriteModule(item);
+		TimelineEnd();
 
-		if(in == NULL)
+		if(TRUE == collectStats)
 		{
-			fprintf(stderr, "can't open '%s'",fname);
-			return;
+			ReportStats(item);
 		}
+		FreeWorkItem(item);
+	}
 
-		rofCount = 0;
-		while(TRUE)
-		{
-			OS9ROF *rfile;
-			int result;
-			FILE *outFile;
+	ThreadJoin(reader);
+	ThreadJoin(disasm);
 
+	if(TRUE == emit[OUTPUT_KDB])
+	{
+		FlushKdb();
+	}
 
-			result = LoadROF(in, &rfile, fname);
-			if(0 != result)
-			{
-				if(0 == rofCount)
-				{
-					error("'%s' does not contain any relocatable object files", fname);
-				}
+	if(TRUE == histflag)
+	{
+		PrintHistogram(&sweepStats);
+	}
 
-				break;
-			}
-			fprintf(stderr, "Disassembling %s\n", rfile->name);
+	if(TRUE == collectStats)
+	{
+		ReportBatchStats();
+	}
 
-			/* Go trace the code */
-			TraceObjectCode(rfile);
+	QueueFree(loadQueue);
+	QueueFree(writeQueue);
+}
 
-			if(TRUE == iflag)
-			{
-				char fname[256];
-				strcpy(fname, rfile->name);
-				strcat(fname, ".asm");
-				outFile = fopen(fname, "w");
-			}
-			else
-			{
-				outFile = stdout;
-			}
-			if(TRUE == rflag)
-			{
-				DumpROFInfo(outFile, rfile);
-			}
-			DisasmObjectCode(outFile, rfile);
-			FreeROF(rfile);
 
-			if(outFile != stdout)
+/*************************************************************************** 
+	Check if a source file was modified since it was last disassembled
+***************************************************************************/
+static BOOL SourceChanged(int16 index)
+{
+	struct stat st;
+	SourceStamp *source;
+
+	source = &sstamps[index];
+
+	if(0 != stat(snames[index], &st))
+	{
+		return FALSE;
+	}
+
+	/*
+		A file rewritten within the same timestamp tick looks unchanged
+		so recently modified files are always rescanned. The module
+		checksums keep that from causing extra disassembly.
+	*/
+	if(st.st_mtime == source->modified
+		&& (long)st.st_size == source->size
+		&& time(NULL) - st.st_mtime > 1)
+	{
+		return FALSE;
+	}
+
+	source->modified = st.st_mtime;
+	source->size = (long)st.st_size;
+
+	return TRUE;
+}
+
+
+void DisassembleROF()
+{
+	int16 count;
+
+	if(scount == 0)
+	{
+		return;
+	}
+
+	for(count = 0; count < scount; count++)
+	{
+		ListInit(&sstamps[count].modules, MEM_OTHER);
+		SourceChanged(count);
+		spending[count] = TRUE;
+	}
+
+	RunPipeline(FALSE);
+}
+
+
+/*************************************************************************** 
+	Wait for source files to change and disassemble the modules in them
+	that were modified.
+***************************************************************************/
+void WatchROF()
+{
+	int16 count;
+
+	if(0 != WatchInit(snames, scount))
+	{
+		error("unable to watch source files");
+	}
+
+	fprintf(stderr, "Watching for changes...\n");
+
+	while(0 == WatchWait())
+	{
+		BOOL changed;
+
+		changed = FALSE;
+		for(count = 0; count < scount; count++)
+		{
+			if(TRUE == SourceChanged(count))
 			{
-				fclose(outFile);
+				spending[count] = TRUE;
+				changed = TRUE;
 			}
+		}
 
-			rofCount++;
+		if(TRUE == changed)
+		{
+			RunPipeline(TRUE);
 		}
-		fclose(in);
 	}
+
+	WatchClose();
 }
 
 
@@ -122,13 +1086,163 @@ void help(void)
 	fprintf(stderr, "-r - dump ROF information\n");
 	fprintf(stderr, "-o - add reference and local offset info\n");
 	fprintf(stderr, "-a - all of the above\n");
+	fprintf(stderr, "--ndjson - generate one JSON record per instruction and data run\n");
+	fprintf(stderr, "--kdb - write a binary disassembly of each file to <file>.kdb\n");
+	fprintf(stderr, "--emit <outputs> - generate several outputs from one pass, any of\n");
+	fprintf(stderr, "         asm,rof,ndjson,xref,kdb. More than one output implies -i\n");
+	fprintf(stderr, "--sweep - decode the code start to finish instead of tracing it\n");
+	fprintf(stderr, "--histogram - sweep without generating output and print opcode counts\n");
+	fprintf(stderr, "--render-threads <n> - render the listing of large modules on n threads\n");
+	fprintf(stderr, "--hints <file> - mark code, data, tables, entry points, and labels\n");
+	fprintf(stderr, "--stats - print the time of each phase and counters per module and in total\n");
+	fprintf(stderr, "--stats-json <file> - write the stats to file as one JSON record per line\n");
+	fprintf(stderr, "--timeline <file> - write when each thread works on which module and\n");
+	fprintf(stderr, "         phase to file as Chrome trace events\n");
+	fprintf(stderr, "--watch - disassemble changed modules when the files change\n");
+	fprintf(stderr, "--journal <file> - record completed modules and resume from them, needs -i\n");
+	fprintf(stderr, "--max-refs <n> - fail modules with more than n references\n");
+	fprintf(stderr, "--max-insns <n> - fail modules needing more than n decode steps\n");
+	fprintf(stderr, "--max-time <seconds> - fail modules taking longer than this\n");
+	fprintf(stderr, "--max-mem <bytes>[k|m] - fail modules using more memory than this\n");
+}
+
+/*************************************************************************** 
+	Get the numeric value of an option
+***************************************************************************/
+static const char *GetOptionValue(int argc, char **argv, int *index)
+{
+	if(++(*index) == argc)
+	{
+		error("missing value for %s", argv[*index - 1]);
+	}
+
+	return argv[*index];
+}
+
+
+static u_int32 ParseSize(const char *value)
+{
+	char *end;
+	unsigned long size;
+
+	size = strtoul(value, &end, 0);
+	switch(*end)
+	{
+	case 'k':
+	case 'K':
+		size *= 1024;
+		break;
+	case 'm':
+	case 'M':
+		size *= 1024 * 1024;
+		break;
+	}
+
+	return (u_int32)size;
+}
+
+
+static u_int32 ParseSeconds(const char *option, const char *value)
+{
+	char *end;
+	double millis;
+
+	millis = strtod(value, &end) * 1000.0;
+	if(end == value || 0 != *end || !(millis > 0.0) || millis > 4294967295.0)
+	{
+		error("invalid value '%s' for %s", value, option);
+	}
+
+	/* Anything under a millisecond would otherwise become no limit */
+	if(millis < 1.0)
+	{
+		millis = 1.0;
+	}
+
+	return (u_int32)millis;
+}
+
+
+/*************************************************************************** 
+	Select the outputs to generate from a comma separated list of names
+***************************************************************************/
+static void SelectOutputs(const char *list)
+{
+	char name[16];
+	int output;
+
+	memset(emit, 0, sizeof(emit));
+
+	while(0 != *list)
+	{
+		size_t length;
+
+		length = strcspn(list, ",");
+		if(length >= sizeof(name))
+		{
+			length = sizeof(name) - 1;
+		}
+		memcpy(name, list, length);
+		name[length] = 0;
+
+		for(output = 0; output < OUTPUT_COUNT; output++)
+		{
+			if(0 == strcmp(name, outputNames[output]))
+			{
+				emit[output] = TRUE;
+				break;
+			}
+		}
+		if(OUTPUT_COUNT == output)
+		{
+			error("unknown output '%s'", name);
+		}
+
+		list += strcspn(list, ",");
+		if(',' == *list)
+		{
+			list++;
+		}
+	}
+
+	/* The journal follows the first output written per module */
+	primaryOutput = OUTPUT_KDB;
+	for(output = OUTPUT_COUNT - 1; output >= 0; output--)
+	{
+		if(TRUE == emit[output] && OUTPUT_KDB != output)
+		{
+			primaryOutput = output;
+		}
+	}
+}
+
+
+static int CountFileOutputs(void)
+{
+	int output;
+	int count;
+
+	count = 0;
+	for(output = 0; output < OUTPUT_COUNT; output++)
+	{
+		if(TRUE == emit[output] && OUTPUT_KDB != output)
+		{
+			count++;
+		}
+	}
+
+	return count;
 }
 
+
 /* symbol table types */
 /* symbol definition/reference type/location */
 int main(int argc, char **argv)
 {
 	int i;
+
+	HexInit();
+	ListInit(&failures, MEM_OTHER);
 	
 	for(i = 1;  i < argc; i++)
 	{
@@ -142,6 +1256,102 @@ int main(int argc, char **argv)
 			exit(0);
 		}
 
+		if(0 == strcmp(p, "--ndjson"))
+		{
+			SelectOutputs("ndjson");
+			continue;
+		}
+
+		if(0 == strcmp(p, "--kdb"))
+		{
+			SelectOutputs("kdb");
+			continue;
+		}
+
+		if(0 == strcmp(p, "--emit"))
+		{
+			SelectOutputs(GetOptionValue(argc, argv, &i));
+			continue;
+		}
+
+		if(0 == strcmp(p, "--sweep"))
+		{
+			sweepflag = TRUE;
+			continue;
+		}
+
+		if(0 == strcmp(p, "--histogram"))
+		{
+			histflag = TRUE;
+			continue;
+		}
+
+		if(0 == strcmp(p, "--render-threads"))
+		{
+			SetRenderThreads(atoi(GetOptionValue(argc, argv, &i)));
+			continue;
+		}
+
+		if(0 == strcmp(p, "--hints"))
+		{
+			hintsName = GetOptionValue(argc, argv, &i);
+			continue;
+		}
+
+		if(0 == strcmp(p, "--stats"))
+		{
+			statsflag = TRUE;
+			continue;
+		}
+
+		if(0 == strcmp(p, "--stats-json"))
+		{
+			statsJsonName = GetOptionValue(argc, argv, &i);
+			continue;
+		}
+
+		if(0 == strcmp(p, "--timeline"))
+		{
+			timelineName = GetOptionValue(argc, argv, &i);
+			continue;
+		}
+
+		if(0 == strcmp(p, "--watch"))
+		{
+			watchflag = TRUE;
+			continue;
+		}
+
+		if(0 == strcmp(p, "--journal"))
+		{
+			journalName = GetOptionValue(argc, argv, &i);
+			continue;
+		}
+
+		if(0 == strcmp(p, "--max-refs"))
+		{
+			limits.maxRefs = ParseSize(GetOptionValue(argc, argv, &i));
+			continue;
+		}
+
+		if(0 == strcmp(p, "--max-insns"))
+		{
+			limits.maxInsns = ParseSize(GetOptionValue(argc, argv, &i));
+			continue;
+		}
+
+		if(0 == strcmp(p, "--max-time"))
+		{
+			limits.maxTime = ParseSeconds(p, GetOptionValue(argc, argv, &i));
+			continue;
+		}
+
+		if(0 == strcmp(p, "--max-mem"))
+		{
+			limits.maxMemory = ParseSize(GetOptionValue(argc, argv, &i));
+			continue;
+		}
+
 		if('-' == *p)
 		{
 			p++;
@@ -171,7 +1381,71 @@ int main(int argc, char **argv)
 		}
 	}
 
+	SetModuleLimits(&limits);
+
+	/* Several outputs can't share stdout so each goes to its own file */
+	if(CountFileOutputs() > 1)
+	{
+		iflag = TRUE;
+	}
+
+	if(NULL != hintsName)
+	{
+		if(0 != LoadHints(hintsName, &hints))
+		{
+			error("%s", GetErrorText());
+		}
+
+		SetDisasmHints(hints);
+	}
+
+	/* Modules written to stdout can't be checked so they are never skipped */
+	if(NULL != journalName && FALSE == iflag)
+	{
+		error("--journal needs -i, only modules written to files can be resumed");
+	}
+
+	if(NULL != journalName && 0 != JournalOpen(journalName))
+	{
+		error("can't open journal '%s'", journalName);
+	}
+
+	if(NULL != statsJsonName)
+	{
+		statsJson = fopen(statsJsonName, "w");
+		if(NULL == statsJson)
+		{
+			error("can't create '%s'", statsJsonName);
+		}
+	}
+	collectStats = TRUE == statsflag || NULL != statsJson ? TRUE : FALSE;
+
+	if(NULL != timelineName)
+	{
+		TimelineEnable();
+	}
+
 	DisassembleROF();
+
+	if(TRUE == watchflag)
+	{
+		WatchROF();
+	}
+
+	JournalClose();
+	FreeHints(hints);
+
+	if(NULL != statsJson)
+	{
+		fclose(statsJson);
+	}
+
+	if(NULL != timelineName && 0 != TimelineWrite(timelineName))
+	{
+		fprintf(stderr, "kdisasm: %s\n", GetErrorText());
+	}
+
+	return 0 == PrintFailures() ? 0 : 1;
 }
 
 
@@ -30,6 +30,12 @@
 #define ROFSYNC     0x62CD2387
 #define SYMLEN      64		/* Length of symbols */
 #define MAXNAME     16		/* length of module name */
+#define MAXOPSIZE   5		/* longest instruction that can run past the code */
+
+/* LoadROF results */
+#define ROF_OK		0		/* module loaded */
+#define ROF_END		-1		/* no more modules in the file */
+#define ROF_ERROR	-2		/* module is malformed, see GetErrorText() */
 
 
 typedef enum
@@ -50,6 +56,29 @@ typedef struct
 
 
 
+typedef struct
+{
+	u_int32			maxRefs;		/* Maximum references in a module */
+	u_int32			maxInsns;		/* Maximum instructions traced and decoded */
+	u_int32			maxTime;		/* Maximum wall time in milliseconds */
+	u_int32			maxMemory;		/* Maximum bytes allocated while loading */
+} ModuleLimits;
+
+
+/*
+	Modules can be read from an open file or from a block of memory. When
+	file is NULL the bytes come from data.
+*/
+typedef struct
+{
+	FILE			*file;		/* File being read */
+	const u_char	*data;		/* Memory being read */
+	u_int32			length;		/* Number of bytes in data */
+	u_int32			position;	/* Read position in data */
+	BOOL			eof;		/* Set when a read runs past the end of data */
+} ROFReader;
+
+
 typedef struct
 {
 	char			name[256];	/* Name of the OS9ROF */
@@ -94,12 +123,26 @@ typedef struct
 
 void error(const char *fmt, ...);
 void ferr(const char *s);
-void read8(FILE *file, u_char *val);
-void read16(FILE *file, u_int16 *retVal);
-void read32(FILE *file, u_int32 *retVal);
-
+void SetError(const char *fmt, ...);
+const char *GetErrorText(void);
+void SetModuleLimits(const ModuleLimits *newLimits);
+void BudgetReset(void);
+int BudgetReference(void);
+int BudgetMemory(u_int32 size);
+int BudgetInstructions(u_int32 count);
+void read8(ROFReader *in, u_char *val);
+void read16(ROFReader *in, u_int16 *retVal);
+void read32(ROFReader *in, u_int32 *retVal);
+
+void ReaderInitFile(ROFReader *in, FILE *file);
+void ReaderInitMemory(ROFReader *in, const u_char *data, u_int32 length);
+int ReaderGetc(ROFReader *in);
 int LoadROF(FILE *in, OS9ROF **retROF, const char *filename);
+int LoadROFReader(ROFReader *in, OS9ROF **retROF, const char *filename);
+const char *GetFailedROFName(void);
+int SkipToNextROF(FILE *in, fpos_t start);
 void FreeROF(OS9ROF *rfile);
+u_int32 GetROFChecksum(FILE *in, OS9ROF *rfile);
 void DumpROFInfo(FILE *outFile, OS9ROF *rof);
 Reference *GetReference(OS9ROF *rfile, REFTYPE type, u_int16 location, BOOL code, BOOL init);
 
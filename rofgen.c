@@ -0,0 +1,1144 @@
+/*****************************************************************************
+	rofgen.c	- Synthetic ROF generator
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Writes relocatable object files made up of legal 6809 code for
+	benchmarks and scaling tests. The output only depends on the options
+	so the same command always writes the same bytes.
+
+	The code of a module is a run of functions with blocks of data in
+	between. Each function ends in a return and calls the one after it
+	so every function is reached from the start of the module. Branches
+	inside a function land on its instructions and calls land on the
+	start of a function. The references are put on instructions with a
+	16 bit operand that were set aside for them while generating.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rof.h"
+#include "textbuf.h"
+
+#define MAX_CODE		0xffff	/* Largest code section of a module */
+#define MAX_FUNCTIONS	4096	/* Most functions in a module */
+#define MAX_FIXUPS		32768	/* Most operands patched in a module */
+#define MAX_SYMBOLS		4096	/* Most external symbols in a module */
+#define MAX_INSN		5		/* Longest instruction generated */
+
+/* Operands filled in once the code is laid out */
+typedef enum
+{
+	FIX_BRANCH,			/* Short branch within the function */
+	FIX_LBRANCH,		/* Long branch within the function */
+	FIX_BSR,			/* Short call, a branch when no function is in range */
+	FIX_LBSR,			/* Long call to any function */
+	FIX_CHAIN,			/* Long call to the next function */
+	FIX_JSR,			/* Extended call, may carry a reference */
+	FIX_IMM16			/* 16 bit immediate, may carry a reference */
+} FIXKIND;
+
+typedef enum
+{
+	MODE_INHERENT,
+	MODE_IMM8,
+	MODE_IMM16,
+	MODE_DIRECT,
+	MODE_EXTENDED,
+	MODE_INDEXED,
+	MODE_STACK,
+	MODE_REGISTER
+} MODE;
+
+typedef struct
+{
+	u_char		page;		/* 0, 0x10 or 0x11 */
+	u_char		code;
+	MODE		mode;
+} Template;
+
+typedef struct
+{
+	u_int16		at;			/* Offset of the instruction */
+	u_int16		function;	/* Function the instruction is in */
+	FIXKIND		kind;
+} Fixup;
+
+typedef struct
+{
+	char		name[SYMLEN];
+	u_char		flag;
+	u_int16		offset;
+} Symbol;
+
+typedef struct
+{
+	u_int16		symbol;		/* External symbol referred to, unused for locals */
+	u_char		flag;
+	u_int16		offset;
+} Site;
+
+typedef struct
+{
+	u_int32		codeSize;		/* Bytes of code per module */
+	u_int32		branches;		/* Percent of instructions that branch or call */
+	u_int32		data;			/* Percent of the code section that is data */
+	u_int32		globals;		/* Global symbols per module */
+	u_int32		locals;			/* Local references per module */
+	u_int32		externals;		/* External references per module */
+	u_int32		initSize;		/* Bytes of initialized data */
+	u_int32		bssSize;		/* Bytes of uninitialized data */
+	u_int32		modules;		/* Modules written to the output */
+	u_int32		seed;
+} GenOptions;
+
+/*
+	Instructions picked from when nothing else is needed. Jumps, calls
+	and instructions that could change the flow through a register are
+	left out since the trace can't follow them.
+*/
+static const Template templates[] =
+{
+	{0x00, 0x12, MODE_INHERENT}, {0x00, 0x3a, MODE_INHERENT}, {0x00, 0x3d, MODE_INHERENT},
+	{0x00, 0x1d, MODE_INHERENT}, {0x00, 0x43, MODE_INHERENT}, {0x00, 0x44, MODE_INHERENT},
+	{0x00, 0x48, MODE_INHERENT}, {0x00, 0x4a, MODE_INHERENT}, {0x00, 0x4c, MODE_INHERENT},
+	{0x00, 0x4d, MODE_INHERENT}, {0x00, 0x4f, MODE_INHERENT}, {0x00, 0x53, MODE_INHERENT},
+	{0x00, 0x58, MODE_INHERENT}, {0x00, 0x5a, MODE_INHERENT}, {0x00, 0x5c, MODE_INHERENT},
+	{0x00, 0x5d, MODE_INHERENT}, {0x00, 0x5f, MODE_INHERENT},
+	{0x00, 0x81, MODE_IMM8}, {0x00, 0x84, MODE_IMM8}, {0x00, 0x86, MODE_IMM8},
+	{0x00, 0x8a, MODE_IMM8}, {0x00, 0x8b, MODE_IMM8}, {0x00, 0xc0, MODE_IMM8},
+	{0x00, 0xc1, MODE_IMM8}, {0x00, 0xc4, MODE_IMM8}, {0x00, 0xc6, MODE_IMM8},
+	{0x00, 0xcb, MODE_IMM8}, {0x00, 0x1c, MODE_IMM8},
+	{0x00, 0x83, MODE_IMM16}, {0x00, 0x8c, MODE_IMM16}, {0x00, 0xc3, MODE_IMM16},
+	{0x10, 0x83, MODE_IMM16}, {0x10, 0x8c, MODE_IMM16}, {0x11, 0x83, MODE_IMM16},
+	{0x00, 0x0c, MODE_DIRECT}, {0x00, 0x0f, MODE_DIRECT}, {0x00, 0x96, MODE_DIRECT},
+	{0x00, 0x97, MODE_DIRECT}, {0x00, 0x9e, MODE_DIRECT}, {0x00, 0x9f, MODE_DIRECT},
+	{0x00, 0xd6, MODE_DIRECT}, {0x00, 0xdc, MODE_DIRECT}, {0x00, 0xdd, MODE_DIRECT},
+	{0x10, 0x9e, MODE_DIRECT}, {0x10, 0xdf, MODE_DIRECT},
+	{0x00, 0x7c, MODE_EXTENDED}, {0x00, 0xb6, MODE_EXTENDED}, {0x00, 0xb7, MODE_EXTENDED},
+	{0x00, 0xfc, MODE_EXTENDED}, {0x00, 0xfd, MODE_EXTENDED}, {0x10, 0xbe, MODE_EXTENDED},
+	{0x00, 0x30, MODE_INDEXED}, {0x00, 0x31, MODE_INDEXED}, {0x00, 0x33, MODE_INDEXED},
+	{0x00, 0x6f, MODE_INDEXED}, {0x00, 0xa6, MODE_INDEXED}, {0x00, 0xa7, MODE_INDEXED},
+	{0x00, 0xab, MODE_INDEXED}, {0x00, 0xae, MODE_INDEXED}, {0x00, 0xaf, MODE_INDEXED},
+	{0x00, 0xe6, MODE_INDEXED}, {0x00, 0xe7, MODE_INDEXED}, {0x00, 0xec, MODE_INDEXED},
+	{0x00, 0xed, MODE_INDEXED}, {0x10, 0xae, MODE_INDEXED}, {0x10, 0xaf, MODE_INDEXED},
+	{0x00, 0x34, MODE_STACK}, {0x00, 0x35, MODE_STACK}, {0x00, 0x36, MODE_STACK},
+	{0x00, 0x1f, MODE_REGISTER}, {0x00, 0x1e, MODE_REGISTER}
+};
+
+#define TEMPLATE_COUNT	(sizeof(templates) / sizeof(templates[0]))
+
+/* Instructions set aside to carry a reference */
+static const Template siteTemplates[] =
+{
+	{0x00, 0x8e, MODE_IMM16},	/* ldx */
+	{0x00, 0xcc, MODE_IMM16},	/* ldd */
+	{0x00, 0xce, MODE_IMM16},	/* ldu */
+	{0x10, 0x8e, MODE_IMM16}	/* ldy */
+};
+
+/* Indexed postbytes without the register bits and the bytes after them */
+static const u_char indexModes[][2] =
+{
+	{0x84, 0}, {0x80, 0}, {0x81, 0}, {0x82, 0}, {0x83, 0}, {0x85, 0}, {0x86, 0},
+	{0x8b, 0}, {0x88, 1}, {0x89, 2}, {0x8c, 1}, {0x8d, 2}, {0x91, 0}, {0x94, 0},
+	{0x98, 1}, {0x99, 2}, {0x9c, 1}, {0x9d, 2}
+};
+
+#define INDEX_MODE_COUNT	(sizeof(indexModes) / sizeof(indexModes[0]))
+
+/* OS-9 service requests made through swi2 */
+static const u_char systemCalls[] = {0x06, 0x84, 0x89, 0x8a, 0x8c, 0x8f};
+
+static u_char code[MAX_CODE + 1];
+static u_char insnStart[MAX_CODE + 1];		/* Set at the first byte of each instruction */
+static u_int32 codeSize;
+static u_int16 functionStart[MAX_FUNCTIONS + 1];
+static u_int32 functionCount;
+static Fixup fixups[MAX_FIXUPS];
+static u_int32 fixupCount;
+static u_int32 siteCount;					/* Fixups that can carry a reference */
+static u_int32 sitePercent;					/* Chance of setting an instruction aside */
+static Symbol globals[MAX_FIXUPS];
+static u_int32 globalCount;
+static Symbol externals[MAX_SYMBOLS];
+static u_int32 externalCount;
+static Site localSites[MAX_FIXUPS];
+static u_int32 localCount;
+static Site externalSites[MAX_FIXUPS];
+static u_int32 externalRefCount;
+static u_int32 randomState;
+static GenOptions options;
+
+
+
+/*************************************************************************** 
+	xorshift generator so the output is the same on every platform
+***************************************************************************/
+static void RandomSeed(u_int32 seed)
+{
+	randomState = (seed * 0x9e3779b9 + 0x6d2b79f5) & 0xffffffff;
+	if(0 == randomState)
+	{
+		randomState = 1;
+	}
+}
+
+
+static u_int32 Random(u_int32 range)
+{
+	randomState ^= (randomState << 13) & 0xffffffff;
+	randomState ^= randomState >> 17;
+	randomState ^= (randomState << 5) & 0xffffffff;
+
+	return 0 != range ? randomState % range : 0;
+}
+
+
+/*************************************************************************** 
+	Add bytes of code at the end of the code generated so far
+***************************************************************************/
+static void Put(u_char value)
+{
+	code[codeSize++] = value;
+}
+
+
+static void Put16(u_int16 value)
+{
+	Put((u_char)(value >> 8));
+	Put((u_char)value);
+}
+
+
+static void AddFixup(FIXKIND kind, u_int32 function)
+{
+	if(MAX_FIXUPS == fixupCount)
+	{
+		error("too many branches and references in one module");
+	}
+
+	fixups[fixupCount].at = (u_int16)codeSize;
+	fixups[fixupCount].function = (u_int16)function;
+	fixups[fixupCount].kind = kind;
+	fixupCount++;
+
+	if(FIX_JSR == kind || FIX_IMM16 == kind)
+	{
+		siteCount++;
+	}
+}
+
+
+/*************************************************************************** 
+	Generate one instruction from a template
+***************************************************************************/
+static void PutTemplate(const Template *insn)
+{
+	u_int32 mode;
+
+	insnStart[codeSize] = TRUE;
+	if(0 != insn->page)
+	{
+		Put(insn->page);
+	}
+	Put(insn->code);
+
+	switch(insn->mode)
+	{
+	case MODE_INHERENT:
+		break;
+
+	case MODE_IMM8:
+	case MODE_DIRECT:
+		Put((u_char)Random(256));
+		break;
+
+	case MODE_IMM16:
+	case MODE_EXTENDED:
+		Put16((u_int16)Random(0x10000));
+		break;
+
+	case MODE_INDEXED:
+		mode = Random(INDEX_MODE_COUNT + 1);
+		if(INDEX_MODE_COUNT == mode)
+		{
+			/* 5 bit offset */
+			Put((u_char)(Random(4) << 5 | Random(32)));
+		}
+		else
+		{
+			Put((u_char)(indexModes[mode][0] | Random(4) << 5));
+			if(2 == indexModes[mode][1])
+			{
+				Put16((u_int16)Random(0x10000));
+			}
+			else if(1 == indexModes[mode][1])
+			{
+				Put((u_char)Random(256));
+			}
+		}
+		break;
+
+	case MODE_STACK:
+		/* Never the program counter */
+		Put((u_char)(1 + Random(0x7f)));
+		break;
+
+	case MODE_REGISTER:
+		/* Registers of the same size and never the program counter */
+		if(0 == Random(2))
+		{
+			Put((u_char)(Random(5) << 4 | Random(5)));
+		}
+		else
+		{
+			Put((u_char)((8 + Random(4)) << 4 | (8 + Random(4))));
+		}
+		break;
+	}
+}
+
+
+/*************************************************************************** 
+	Generate an instruction that branches or calls
+***************************************************************************/
+static void PutBranch(u_int32 function)
+{
+	u_int32 kind;
+
+	kind = Random(100);
+	insnStart[codeSize] = TRUE;
+
+	if(kind < 50)
+	{
+		AddFixup(FIX_BRANCH, function);
+		Put((u_char)(0x21 + Random(15)));
+		Put(0);
+	}
+	else if(kind < 60)
+	{
+		AddFixup(FIX_LBRANCH, function);
+		Put(0x10);
+		Put((u_char)(0x21 + Random(15)));
+		Put16(0);
+	}
+	else if(kind < 70)
+	{
+		AddFixup(FIX_BSR, function);
+		Put(0x8d);
+		Put(0);
+	}
+	else if(kind < 80)
+	{
+		AddFixup(FIX_LBSR, function);
+		Put(0x17);
+		Put16(0);
+	}
+	else if(kind < 95)
+	{
+		AddFixup(FIX_JSR, function);
+		Put(0xbd);
+		Put16(0);
+	}
+	else
+	{
+		Put(0x10);
+		Put(0x3f);
+		Put(systemCalls[Random(sizeof(systemCalls))]);
+	}
+}
+
+
+/*************************************************************************** 
+	Generate a function of about size bytes ending in a return
+***************************************************************************/
+static void PutFunction(u_int32 size)
+{
+	u_int32 function;
+	u_int32 end;
+	u_int32 chainAt;
+	BOOL chained;
+	BOOL pull;
+
+	function = functionCount++;
+	functionStart[function] = (u_int16)codeSize;
+
+	/* Room is left for the return */
+	pull = 0 == Random(2) ? TRUE : FALSE;
+	end = codeSize + size - (TRUE == pull ? 2 : 1);
+	chainAt = codeSize + Random(size);
+	chained = FALSE;
+
+	while(codeSize + MAX_INSN <= end)
+	{
+		if(FALSE == chained && (codeSize >= chainAt || codeSize + MAX_INSN + 3 > end))
+		{
+			insnStart[codeSize] = TRUE;
+			AddFixup(FIX_CHAIN, function);
+			Put(0x17);
+			Put16(0);
+			chained = TRUE;
+		}
+		else if(Random(100) < options.branches)
+		{
+			PutBranch(function);
+		}
+		else if(Random(100) < sitePercent)
+		{
+			AddFixup(FIX_IMM16, function);
+			PutTemplate(&siteTemplates[Random(sizeof(siteTemplates) / sizeof(siteTemplates[0]))]);
+		}
+		else
+		{
+			PutTemplate(&templates[Random(TEMPLATE_COUNT)]);
+		}
+	}
+
+	/* Fill up to the return */
+	while(codeSize < end)
+	{
+		insnStart[codeSize] = TRUE;
+		Put(0 == Random(2) ? 0x12 : 0x4c);
+	}
+
+	insnStart[codeSize] = TRUE;
+	if(TRUE == pull)
+	{
+		/* puls with the program counter */
+		Put(0x35);
+		Put((u_char)(0x80 | Random(0x80)));
+	}
+	else
+	{
+		Put(0x39);
+	}
+}
+
+
+/*************************************************************************** 
+	Generate a block of data, either text or a table of bytes
+***************************************************************************/
+static void PutData(u_int32 size)
+{
+	u_int32 count;
+
+	if(0 == Random(2))
+	{
+		for(count = 1; count < size; count++)
+		{
+			Put((u_char)(0 == Random(6) ? ' ' : 'a' + Random(26)));
+		}
+		Put(0 == Random(2) ? 0x0d : 0x00);
+	}
+	else
+	{
+		for(count = 0; count < size; count++)
+		{
+			Put((u_char)Random(256));
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Lay out the functions and data of the code section
+***************************************************************************/
+static void GenerateCode(void)
+{
+	u_int32 dataBytes;
+
+	memset(insnStart, 0, sizeof(insnStart));
+	codeSize = 0;
+	functionCount = 0;
+	fixupCount = 0;
+	siteCount = 0;
+	dataBytes = 0;
+
+	while(codeSize < options.codeSize)
+	{
+		u_int32 remaining;
+		u_int32 size;
+
+		remaining = options.codeSize - codeSize;
+
+		/* Data keeps to its share of what was generated so far */
+		if((0 != functionCount && dataBytes * 100 < codeSize * options.data)
+			|| remaining < 16
+			|| MAX_FUNCTIONS == functionCount)
+		{
+			size = 4 + Random(60);
+			size = size < remaining ? size : remaining;
+			PutData(size);
+			dataBytes += size;
+		}
+		else
+		{
+			size = 24 + Random(200);
+			size = size + 16 <= remaining ? size : remaining;
+			PutFunction(size);
+		}
+	}
+
+	/* A module too small for a function still gets a return */
+	if(0 == functionCount && 0 != codeSize)
+	{
+		code[0] = 0x39;
+		insnStart[0] = TRUE;
+		functionStart[functionCount++] = 0;
+	}
+}
+
+
+/*************************************************************************** 
+	Pick a function starting within reach of a short branch to be taken
+	from next, or return FALSE if there is none
+***************************************************************************/
+static BOOL FindNearFunction(u_int32 next, u_int16 *target)
+{
+	u_int32 low;
+	u_int32 high;
+	u_int32 first;
+	u_int32 count;
+
+	low = next >= 128 ? next - 128 : 0;
+	high = next + 127;
+
+	/* Functions are in address order */
+	for(first = 0; first < functionCount && functionStart[first] < low; first++);
+	for(count = 0; first + count < functionCount && functionStart[first + count] <= high; count++);
+
+	if(0 == count)
+	{
+		return FALSE;
+	}
+
+	*target = functionStart[first + Random(count)];
+	return TRUE;
+}
+
+
+/*************************************************************************** 
+	Pick an instruction of a function, within reach of a short branch to
+	be taken from next if near is set. The instruction at next is always
+	in reach so there is one to fall back on.
+***************************************************************************/
+static u_int16 FindTarget(u_int32 function, u_int32 next, BOOL near)
+{
+	u_int32 start;
+	u_int32 end;
+	int tries;
+
+	start = functionStart[function];
+	end = function + 1 < functionCount ? functionStart[function + 1] : codeSize;
+
+	if(TRUE == near)
+	{
+		start = start + 128 > next ? start : next - 128;
+		end = end < next + 128 ? end : next + 128;
+	}
+
+	for(tries = 0; tries < 16; tries++)
+	{
+		u_int32 pc;
+
+		pc = start + Random(end - start);
+		if(TRUE == insnStart[pc])
+		{
+			return (u_int16)pc;
+		}
+	}
+
+	return (u_int16)next;
+}
+
+
+
+static void PatchRelative(u_int32 at, u_int32 next, u_int16 target)
+{
+	u_int16 offset;
+
+	offset = (u_int16)(target - next);
+	code[at] = (u_char)(offset >> 8);
+	code[at + 1] = (u_char)offset;
+}
+
+
+/*************************************************************************** 
+	Put a reference on an instruction set aside for one, or give it a
+	plain operand if more were set aside than references asked for.
+	External references are handed out first.
+***************************************************************************/
+static void AssignSite(const Fixup *fix, u_int32 index)
+{
+	u_int32 operand;
+	u_int16 value;
+	Site *site;
+
+	operand = fix->at + (0x10 == code[fix->at] ? 2 : 1);
+
+	if(index < options.externals)
+	{
+		site = &externalSites[externalRefCount++];
+		site->symbol = (u_int16)Random(externalCount);
+		site->flag = CODLOC;
+		site->offset = (u_int16)operand;
+		code[operand] = 0;
+		code[operand + 1] = 0;
+		return;
+	}
+
+	if(index < options.externals + options.locals)
+	{
+		u_int32 kind;
+
+		site = &localSites[localCount++];
+		site->symbol = 0;
+		site->offset = (u_int16)operand;
+
+		/* Calls refer to code, loads to any section */
+		kind = FIX_JSR == fix->kind ? 0 : Random(3);
+		if(1 == kind && 0 != options.initSize)
+		{
+			site->flag = CODLOC | INIENT;
+			value = (u_int16)Random(options.initSize);
+		}
+		else if(2 == kind && 0 != options.bssSize)
+		{
+			site->flag = CODLOC;
+			value = (u_int16)Random(options.bssSize);
+		}
+		else
+		{
+			site->flag = CODLOC | CODENT;
+			value = functionStart[Random(functionCount)];
+		}
+
+		code[operand] = (u_char)(value >> 8);
+		code[operand + 1] = (u_char)value;
+		return;
+	}
+
+	/* Calls without a reference become relative */
+	if(FIX_JSR == fix->kind)
+	{
+		code[fix->at] = 0x17;
+		PatchRelative(fix->at + 1, fix->at + 3, functionStart[Random(functionCount)]);
+	}
+}
+
+
+/*************************************************************************** 
+	Fill in the branches and calls and put the references on the
+	instructions set aside for them
+***************************************************************************/
+static void ResolveFixups(void)
+{
+	static u_int32 order[MAX_FIXUPS];
+	u_int32 count;
+	u_int32 index;
+
+	/* The set aside instructions get their references in a random order */
+	count = 0;
+	for(index = 0; index < fixupCount; index++)
+	{
+		if(FIX_JSR == fixups[index].kind || FIX_IMM16 == fixups[index].kind)
+		{
+			order[count++] = index;
+		}
+	}
+	for(index = count; index > 1; index--)
+	{
+		u_int32 other;
+		u_int32 swap;
+
+		other = Random(index);
+		swap = order[index - 1];
+		order[index - 1] = order[other];
+		order[other] = swap;
+	}
+
+	if(count < options.externals + options.locals)
+	{
+		fprintf(stderr, "rofgen: only %lu of %lu references fit in the code\n",
+			(unsigned long)count,
+			(unsigned long)(options.externals + options.locals));
+	}
+
+	localCount = 0;
+	externalRefCount = 0;
+	for(index = 0; index < count; index++)
+	{
+		AssignSite(&fixups[order[index]], index);
+	}
+
+	for(index = 0; index < fixupCount; index++)
+	{
+		Fixup *fix;
+		u_int16 target;
+
+		fix = &fixups[index];
+		switch(fix->kind)
+		{
+		case FIX_BRANCH:
+			target = FindTarget(fix->function, fix->at + 2, TRUE);
+			code[fix->at + 1] = (u_char)(target - (fix->at + 2));
+			break;
+
+		case FIX_LBRANCH:
+			target = FindTarget(fix->function, fix->at + 4, FALSE);
+			PatchRelative(fix->at + 2, fix->at + 4, target);
+			break;
+
+		case FIX_BSR:
+			if(FALSE == FindNearFunction(fix->at + 2, &target))
+			{
+				/* Nothing to call, so branch if not equal */
+				code[fix->at] = 0x26;
+				target = FindTarget(fix->function, fix->at + 2, TRUE);
+			}
+			code[fix->at + 1] = (u_char)(target - (fix->at + 2));
+			break;
+
+		case FIX_LBSR:
+			PatchRelative(fix->at + 1, fix->at + 3, functionStart[Random(functionCount)]);
+			break;
+
+		case FIX_CHAIN:
+			target = functionStart[(u_int32)fix->function + 1 < functionCount ? fix->function + 1 : 0];
+			PatchRelative(fix->at + 1, fix->at + 3, target);
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Add a global symbol
+***************************************************************************/
+static void AddGlobal(const char *prefix, u_int32 number, u_char flag, u_int16 offset)
+{
+	Symbol *symbol;
+
+	symbol = &globals[globalCount++];
+	sprintf(symbol->name, "%s%lu", prefix, (unsigned long)number);
+	symbol->flag = flag;
+	symbol->offset = offset;
+}
+
+
+/*************************************************************************** 
+	Export the start of the module and other functions first, then
+	places in the data and finally other instructions
+***************************************************************************/
+static void GenerateGlobals(void)
+{
+	static u_int16 order[MAX_FUNCTIONS];
+	u_int32 index;
+	u_int32 count;
+
+	globalCount = 0;
+	if(0 == options.globals || 0 == functionCount)
+	{
+		return;
+	}
+
+	for(index = 0; index < functionCount; index++)
+	{
+		order[index] = (u_int16)index;
+	}
+	for(index = functionCount; index > 2; index--)
+	{
+		u_int32 other;
+		u_int16 swap;
+
+		other = 1 + Random(index - 1);
+		swap = order[index - 1];
+		order[index - 1] = order[other];
+		order[other] = swap;
+	}
+
+	count = options.globals < MAX_FIXUPS ? options.globals : MAX_FIXUPS;
+	for(index = 0; index < functionCount && globalCount < count; index++)
+	{
+		AddGlobal("func", order[index], CODENT, functionStart[order[index]]);
+	}
+
+	for(index = 0; globalCount < count; index++)
+	{
+		if(0 == index % 2 && 0 != options.initSize)
+		{
+			AddGlobal("data", index, INIENT, (u_int16)Random(options.initSize));
+		}
+		else if(0 != options.bssSize)
+		{
+			AddGlobal("bss", index, 0, (u_int16)Random(options.bssSize));
+		}
+		else
+		{
+			u_int32 pc;
+
+			do
+			{
+				pc = Random(codeSize);
+			}
+			while(FALSE == insnStart[pc]);
+
+			AddGlobal("code", index, CODENT, (u_int16)pc);
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Write the parts of a module in the byte order of the 6809
+***************************************************************************/
+static void Write8(TextBuf *out, u_char value)
+{
+	if(0 > TextBufWrite(out, (const char *)&value, 1))
+	{
+		error("out of memory");
+	}
+}
+
+
+static void Write16(TextBuf *out, u_int16 value)
+{
+	Write8(out, (u_char)(value >> 8));
+	Write8(out, (u_char)value);
+}
+
+
+static void WriteString(TextBuf *out, const char *text)
+{
+	if(0 > TextBufWrite(out, text, (u_int32)strlen(text) + 1))
+	{
+		error("out of memory");
+	}
+}
+
+
+/*************************************************************************** 
+	Generate a module and add it to out
+***************************************************************************/
+static void GenerateModule(TextBuf *out, u_int32 index)
+{
+	static const u_char date[5] = {118, 1, 1, 0, 0};
+	char name[32];
+	u_int32 estimate;
+	u_int32 count;
+	u_int32 symbol;
+
+	/* Each module has its own sequence so it doesn't depend on the others */
+	RandomSeed(options.seed + index * 7919);
+
+	/*
+		Set aside enough instructions for the references, going by about
+		two and a half bytes per instruction
+	*/
+	estimate = options.codeSize * (100 - options.data) / 250 * (100 - options.branches) / 100;
+	sitePercent = options.locals + options.externals;
+	sitePercent = 0 == sitePercent ? 0 : 1 + sitePercent * 150 / (0 != estimate ? estimate : 1);
+	sitePercent = sitePercent < 90 ? sitePercent : 90;
+
+	externalCount = 0 == options.externals ? 0 : (options.externals + 3) / 4;
+	externalCount = externalCount < MAX_SYMBOLS ? externalCount : MAX_SYMBOLS;
+	for(symbol = 0; symbol < externalCount; symbol++)
+	{
+		sprintf(externals[symbol].name, "ext%lu", (unsigned long)symbol);
+	}
+
+	GenerateCode();
+	ResolveFixups();
+	GenerateGlobals();
+
+	sprintf(name, "gen%lu", (unsigned long)index);
+
+	/* Header */
+	Write16(out, (u_int16)(ROFSYNC >> 16));
+	Write16(out, (u_int16)ROFSYNC);
+	Write16(out, 0x0101);
+	Write8(out, 0);
+	for(count = 0; count < sizeof(date); count++)
+	{
+		Write8(out, date[count]);
+	}
+	Write8(out, 1);
+	Write8(out, 0);
+	Write16(out, (u_int16)options.bssSize);
+	Write16(out, 0);
+	Write16(out, (u_int16)options.initSize);
+	Write16(out, 0);
+	Write16(out, (u_int16)codeSize);
+	Write16(out, 0x100);
+	Write16(out, 0);
+	WriteString(out, name);
+
+	/* Globals */
+	Write16(out, (u_int16)globalCount);
+	for(count = 0; count < globalCount; count++)
+	{
+		WriteString(out, globals[count].name);
+		Write8(out, globals[count].flag);
+		Write16(out, globals[count].offset);
+	}
+
+	/* Code and initialized data, text first */
+	if(0 > TextBufWrite(out, (const char *)code, codeSize))
+	{
+		error("out of memory");
+	}
+	for(count = 0; count < options.initSize; count++)
+	{
+		Write8(out, (u_char)(0 == Random(2) ? 'a' + Random(26) : Random(256)));
+	}
+
+	/* External references grouped by symbol */
+	Write16(out, (u_int16)externalCount);
+	for(symbol = 0; symbol < externalCount; symbol++)
+	{
+		u_int32 uses;
+
+		uses = 0;
+		for(count = 0; count < externalRefCount; count++)
+		{
+			uses += symbol == externalSites[count].symbol;
+		}
+
+		WriteString(out, externals[symbol].name);
+		Write16(out, (u_int16)uses);
+		for(count = 0; count < externalRefCount; count++)
+		{
+			if(symbol == externalSites[count].symbol)
+			{
+				Write8(out, externalSites[count].flag);
+				Write16(out, externalSites[count].offset);
+			}
+		}
+	}
+
+	/* Local references */
+	Write16(out, (u_int16)localCount);
+	for(count = 0; count < localCount; count++)
+	{
+		Write8(out, localSites[count].flag);
+		Write16(out, localSites[count].offset);
+	}
+}
+
+
+void help(void)
+{
+	fprintf(stderr, "rofgen:  writes synthetic relocatable object files of 6809 code\n");
+	fprintf(stderr, "usage: rofgen [opts] <file>\n");
+	fprintf(stderr, "options:\n");
+	fprintf(stderr, "--modules <n> - number of modules, more than one makes a library (1)\n");
+	fprintf(stderr, "--code <bytes>[k] - size of the code of each module (4k)\n");
+	fprintf(stderr, "--branches <percent> - instructions that branch or call (15)\n");
+	fprintf(stderr, "--data <percent> - share of the code section that is data (10)\n");
+	fprintf(stderr, "--globals <n> - global symbols per module (8)\n");
+	fprintf(stderr, "--locals <n> - local references per module (32)\n");
+	fprintf(stderr, "--externals <n> - external references per module (16)\n");
+	fprintf(stderr, "--init <bytes> - size of the initialized data (256)\n");
+	fprintf(stderr, "--bss <bytes> - size of the uninitialized data (512)\n");
+	fprintf(stderr, "--seed <n> - start of the random sequence (1)\n");
+}
+
+
+/*************************************************************************** 
+	Get the numeric value of an option
+***************************************************************************/
+static u_int32 GetOptionValue(int argc, char **argv, int *index)
+{
+	char *end;
+	unsigned long value;
+
+	if(++(*index) == argc)
+	{
+		error("missing value for %s", argv[*index - 1]);
+	}
+
+	value = strtoul(argv[*index], &end, 0);
+	if('k' == *end || 'K' == *end)
+	{
+		value *= 1024;
+		end++;
+	}
+	if(0 != *end)
+	{
+		error("bad value for %s", argv[*index - 1]);
+	}
+
+	return (u_int32)value;
+}
+
+
+int main(int argc, char **argv)
+{
+	const char *outName;
+	FILE *outFile;
+	TextBuf out;
+	u_int32 index;
+	int i;
+
+	options.codeSize = 4096;
+	options.branches = 15;
+	options.data = 10;
+	options.globals = 8;
+	options.locals = 32;
+	options.externals = 16;
+	options.initSize = 256;
+	options.bssSize = 512;
+	options.modules = 1;
+	options.seed = 1;
+	outName = NULL;
+
+	for(i = 1; i < argc; i++)
+	{
+		const char *p;
+
+		p = argv[i];
+
+		if(0 == strcmp(p, "-help") || 0 == strcmp(p, "--help"))
+		{
+			help();
+			exit(0);
+		}
+		else if(0 == strcmp(p, "--modules"))
+		{
+			options.modules = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--code"))
+		{
+			options.codeSize = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--branches"))
+		{
+			options.branches = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--data"))
+		{
+			options.data = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--globals"))
+		{
+			options.globals = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--locals"))
+		{
+			options.locals = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--externals"))
+		{
+			options.externals = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--init"))
+		{
+			options.initSize = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--bss"))
+		{
+			options.bssSize = GetOptionValue(argc, argv, &i);
+		}
+		else if(0 == strcmp(p, "--seed"))
+		{
+			options.seed = GetOptionValue(argc, argv, &i);
+		}
+		else if('-' == *p)
+		{
+			error("unknown option %s", p);
+		}
+		else if(NULL != outName)
+		{
+			error("only one output file can be written");
+		}
+		else
+		{
+			outName = p;
+		}
+	}
+
+	if(NULL == outName)
+	{
+		help();
+		exit(1);
+	}
+
+	if(0 == options.codeSize || options.codeSize > MAX_CODE)
+	{
+		error("code size must be from 1 to %lu bytes", (unsigned long)MAX_CODE);
+	}
+	if(options.branches > 100 || options.data >= 100)
+	{
+		error("branches must be at most 100%% and data less than 100%%");
+	}
+	if(options.initSize > 0xffff || options.bssSize > 0xffff)
+	{
+		error("data sizes must be less than 64k");
+	}
+	if(options.locals + options.externals >= MAX_FIXUPS || options.globals >= MAX_FIXUPS)
+	{
+		error("too many references");
+	}
+
+	TextBufInit(&out);
+	for(index = 0; index < options.modules; index++)
+	{
+		GenerateModule(&out, index);
+	}
+
+	outFile = fopen(outName, "wb");
+	if(NULL == outFile)
+	{
+		error("can't create '%s'", outName);
+	}
+
+	fwrite(out.text, 1, out.length, outFile);
+	if(0 != ferror(outFile))
+	{
+		error("error writing '%s'", outName);
+	}
+	fclose(outFile);
+
+	TextBufFree(&out);
+
+	return 0;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -13,13 +13,110 @@
 #include <io.h>
 #include <assert.h>
 #include "rof.h"
+#include "stats.h"
 
 char *fname;
 
-static void GetOffset(FILE *in, OS9ROF *rfile, fpos_t *retPos)
+/*************************************************************************** 
+	Set up a reader for an open file
+***************************************************************************/
+void ReaderInitFile(ROFReader *in, FILE *file)
+{
+	memset(in, 0, sizeof(ROFReader));
+	in->file = file;
+}
+
+
+/*************************************************************************** 
+	Set up a reader for a block of memory
+***************************************************************************/
+void ReaderInitMemory(ROFReader *in, const u_char *data, u_int32 length)
+{
+	memset(in, 0, sizeof(ROFReader));
+	in->data = data;
+	in->length = length;
+}
+
+
+/*************************************************************************** 
+	Read a single byte. Returns EOF at the end of the input.
+***************************************************************************/
+int ReaderGetc(ROFReader *in)
+{
+	if(NULL != in->file)
+	{
+		return getc(in->file);
+	}
+
+	if(in->position >= in->length)
+	{
+		in->eof = TRUE;
+		return EOF;
+	}
+
+	return in->data[in->position++];
+}
+
+
+static size_t ReaderRead(ROFReader *in, void *buffer, size_t size)
+{
+	if(NULL != in->file)
+	{
+		return fread(buffer, 1, size, in->file);
+	}
+
+	if(size > in->length - in->position)
+	{
+		size = in->length - in->position;
+		in->eof = TRUE;
+	}
+
+	memcpy(buffer, in->data + in->position, size);
+	in->position += (u_int32)size;
+
+	return size;
+}
+
+
+static void ReaderTell(ROFReader *in, fpos_t *retPos)
+{
+	if(NULL != in->file)
+	{
+		fgetpos(in->file, retPos);
+	}
+	else
+	{
+		*retPos = (fpos_t)in->position;
+	}
+}
+
+
+static long ReaderLength(ROFReader *in)
+{
+	if(NULL != in->file)
+	{
+		return filelength(fileno(in->file));
+	}
+
+	return (long)in->length;
+}
+
+
+static BOOL ReaderFailed(ROFReader *in)
+{
+	if(NULL != in->file)
+	{
+		return (feof(in->file) || ferror(in->file)) ? TRUE : FALSE;
+	}
+
+	return in->eof;
+}
+
+
+static void GetOffset(ROFReader *in, OS9ROF *rfile, fpos_t *retPos)
 {
 	fpos_t pos;
-	fgetpos(in, &pos);
+	ReaderTell(in, &pos);
 
 	*retPos = pos - rfile->offsetBase;
 }
@@ -54,15 +151,47 @@ static void hexadump(FILE *outfile, u_char *s, int length)
 }
 
 
+/*************************************************************************** 
+	Allocate zeroed memory from pool charged against the module memory
+	budget
+***************************************************************************/
+static void *AllocModule(MEMPOOL pool, size_t size)
+{
+	void *mem;
+
+	if(0 != BudgetMemory((u_int32)size))
+	{
+		return NULL;
+	}
+
+	mem = MemAlloc(pool, (u_int32)size);
+	if(NULL == mem)
+	{
+		SetError("out of memory");
+	}
+
+	return mem;
+}
+
+
 /*************************************************************************** 
 ***************************************************************************/
-static int ReadString(FILE *in, char *s)
+static int ReadString(ROFReader *in, char *s)
 {
 	int count = 0;
 
 	while(TRUE)
 	{
-		*s = getc(in);
+		int c;
+
+		c = ReaderGetc(in);
+		if(EOF == c)
+		{
+			SetError("unexpected end of file reading symbol");
+			return -1;
+		}
+
+		*s = (char)c;
 		if(0 == *s)
 		{
 			break;
@@ -72,14 +201,15 @@ static int ReadString(FILE *in, char *s)
 
 		if(SYMLEN == count)
 		{
-			error("Long symbol name encountered");
-			break;
+			SetError("long symbol name encountered");
+			return -1;
 		}
 	}
 
-	if(ferror(in))
+	if(NULL != in->file && ferror(in->file))
 	{
-		error("Error reading string from file!\n");
+		SetError("error reading string from file");
+		return -1;
 	}
 
 	return (count);
@@ -123,6 +253,7 @@ Reference *GetReference(OS9ROF *rfile, REFTYPE type, u_int16 location, BOOL code
 		}
 
 		node = NodeGetNext(rfile->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
 	}
 
 	return NULL;
@@ -163,21 +294,32 @@ Reference *AddReference(OS9ROF *rfile, REFTYPE type, char *sym, u_char flag, u_i
 		fprintf(stderr, "Reference invalid!\n");
 	}
 
-	ref = malloc(sizeof(Reference));
+	/* The list node is charged along with the reference */
+	if(0 != BudgetReference() || 0 != BudgetMemory(3 * sizeof(void *)))
+	{
+		return NULL;
+	}
+
+	ref = AllocModule(MEM_REFERENCES, sizeof(Reference));
 	if(NULL != ref)
 	{
 		ref->type = type;
 		ref->symbol = sym;
 		ref->flag = flag;
 		ref->offset = offset;
-		ListAddTail(rfile->refList, ref);
+		if(NULL == ListAddTail(rfile->refList, ref))
+		{
+			SetError("out of memory");
+			MemFree(ref);
+			ref = NULL;
+		}
 	}
 
 	return ref;
 }
 
 
-static int LoadGlobals(FILE *in, OS9ROF *rfile)
+static int LoadGlobals(ROFReader *in, OS9ROF *rfile)
 {
 	int i;
 	char symbuf[SYMLEN+1];
@@ -197,17 +339,35 @@ static int LoadGlobals(FILE *in, OS9ROF *rfile)
 			int length;
 			/* Read the global entry */
 			length = ReadString(in, symbuf);
+			if(length < 0)
+			{
+				return ROF_ERROR;
+			}
 			read8(in, &flag);
 			read16(in, &offset);
 
 			/* Copy the symbol name over */
-			symbol = malloc(length + 1);
+			symbol = AllocModule(MEM_SYMBOLS, length + 1);
+			if(NULL == symbol)
+			{
+				return ROF_ERROR;
+			}
 			strcpy(symbol, symbuf);
 
-			AddReference(rfile, REF_GLOBAL, symbol, flag, offset);
+			if(NULL == AddReference(rfile, REF_GLOBAL, symbol, flag, offset))
+			{
+				MemFree(symbol);
+				return ROF_ERROR;
+			}
 		}
 	}
 
+	if(TRUE == ReaderFailed(in))
+	{
+		SetError("truncated global references");
+		return ROF_ERROR;
+	}
+
 	return 0;
 }
 
@@ -221,7 +381,7 @@ static int LoadGlobals(FILE *in, OS9ROF *rfile)
 	byte		flag
 	word		offset
 ***************************************************************************/
-static int LoadLocalRefs(FILE *in, OS9ROF *rfile)
+static int LoadLocalRefs(ROFReader *in, OS9ROF *rfile)
 {
 	u_int16 count;
 	u_char flag;
@@ -239,10 +399,19 @@ static int LoadLocalRefs(FILE *in, OS9ROF *rfile)
 			read8(in, &flag);
 			read16(in, &offset);
 
-			AddReference(rfile, REF_LOCAL, NULL, flag, offset);
+			if(NULL == AddReference(rfile, REF_LOCAL, NULL, flag, offset))
+			{
+				return ROF_ERROR;
+			}
 		}
 	}
 
+	if(TRUE == ReaderFailed(in))
+	{
+		SetError("truncated local references");
+		return ROF_ERROR;
+	}
+
 	return 0;
 }
 
@@ -260,7 +429,7 @@ static int LoadLocalRefs(FILE *in, OS9ROF *rfile)
 	byte		flag
 	word		offset
 ***************************************************************************/
-static int LoadExtRefs(FILE *in, OS9ROF *rfile)
+static int LoadExtRefs(ROFReader *in, OS9ROF *rfile)
 {
 	char sym[SYMLEN+1];
 	char *symbol;
@@ -286,7 +455,15 @@ static int LoadExtRefs(FILE *in, OS9ROF *rfile)
 
 			/* Read the string */
 			length = ReadString(in, sym);
-			symbol = malloc(length + 1);
+			if(length < 0)
+			{
+				return ROF_ERROR;
+			}
+			symbol = AllocModule(MEM_SYMBOLS, length + 1);
+			if(NULL == symbol)
+			{
+				return ROF_ERROR;
+			}
 			strcpy(symbol, sym);
 
 			/* Read the count */
@@ -299,32 +476,58 @@ static int LoadExtRefs(FILE *in, OS9ROF *rfile)
 				{
 					read8(in, &flag);
 					read16(in, &offset);
-					AddReference(rfile, REF_EXTERNAL, symbol, flag, offset);
+					if(NULL == AddReference(rfile, REF_EXTERNAL, symbol, flag, offset))
+					{
+						/* Once a reference holds the symbol it is freed with the module */
+						if(0 == x)
+						{
+							MemFree(symbol);
+						}
+						return ROF_ERROR;
+					}
 				}
 			}
+			else
+			{
+				MemFree(symbol);
+			}
 		}
 	}
 
+	if(TRUE == ReaderFailed(in))
+	{
+		SetError("truncated external references");
+		return ROF_ERROR;
+	}
+
 	return 0;
 }
 
 
 /*************************************************************************** 
 	Load object code
+
+	The code is padded with zeros so an instruction running off the end
+	of the code is never decoded from outside the buffer.
 ***************************************************************************/
-int LoadCode(FILE *in, OS9ROF *rfile)
+static int LoadCode(ROFReader *in, OS9ROF *rfile)
 {
 	GetOffset(in, rfile, &rfile->offsetCode);
 
 	if(0 != rfile->sizeObjectCode)
 	{
 		size_t result;
-		rfile->objectCode = malloc(rfile->sizeObjectCode);
+		rfile->objectCode = AllocModule(MEM_LOADER, rfile->sizeObjectCode + MAXOPSIZE);
+		if(NULL == rfile->objectCode)
+		{
+			return ROF_ERROR;
+		}
 
-		result = fread(rfile->objectCode, 1, rfile->sizeObjectCode, in);
+		result = ReaderRead(in, rfile->objectCode, rfile->sizeObjectCode);
 		if(result != rfile->sizeObjectCode)
 		{
-			return -1;
+			SetError("truncated object code");
+			return ROF_ERROR;
 		}
 	}
 
@@ -353,34 +556,34 @@ int LoadCode(FILE *in, OS9ROF *rfile)
 	word		Size of stack space
 	word		Execution entry point
 ***************************************************************************/
-static int ReadROFHeader(FILE *in, OS9ROF *rfile)
+static int ReadROFHeader(ROFReader *in, OS9ROF *rfile)
 {
 	int length;
 	u_int32	sync;
 
 	/* Get the location in the file */
-	fgetpos(in, &rfile->offsetBase);
+	ReaderTell(in, &rfile->offsetBase);
 
 	/* Check for end of file */
-	length = filelength(fileno(in));
+	length = ReaderLength(in);
 	if(rfile->offsetBase >= length)
 	{
-		return -1;
+		return ROF_END;
 	}
 
 	/* Read and check the sync bytes */
 	read32(in, &sync);
 	if(sync != ROFSYNC)
 	{
-		return -1;
+		return ROF_END;
 	}
 
 	/* Read the rest of the header */
 	read16(in, &rfile->typeLanguage);
 	read8(in, &rfile->asmVaild);
-	fread(rfile->creationDate, 5, 1, in);
+	ReaderRead(in, rfile->creationDate, 5);
 	read8(in, &rfile->edition);
-	fgetc(in);	/* Skip the unused byte */
+	ReaderGetc(in);	/* Skip the unused byte */
 	read16(in, &rfile->sizeUninitData);
 	read16(in, &rfile->sizeUninitDPData);
 	read16(in, &rfile->sizeInitData);
@@ -388,7 +591,10 @@ static int ReadROFHeader(FILE *in, OS9ROF *rfile)
 	read16(in, &rfile->sizeObjectCode);
 	read16(in, &rfile->sizeStack);
 	read16(in, &rfile->execEntry);
-	ReadString(in, rfile->name);
+	if(ReadString(in, rfile->name) < 0)
+	{
+		return ROF_ERROR;
+	}
 
 	return 0;
 }
@@ -396,15 +602,113 @@ static int ReadROFHeader(FILE *in, OS9ROF *rfile)
 
 
 /*************************************************************************** 
-	Free an allocated OS9ROF structure
+	Calculate a checksum of the raw bytes of a loaded ROF so changed
+	modules can be detected without disassembling them.
+***************************************************************************/
+u_int32 GetROFChecksum(FILE *in, OS9ROF *rfile)
+{
+	fpos_t pos;
+	u_char buffer[512];
+	u_int32 hash;
+	size_t length;
+
+	fgetpos(in, &pos);
+	fsetpos(in, &rfile->offsetBase);
+
+	hash = HASH_INIT;
+	length = (size_t)rfile->hdrSize;
+	while(length > 0)
+	{
+		size_t count;
+
+		count = fread(buffer, 1, length < sizeof(buffer) ? length : sizeof(buffer), in);
+		if(0 == count)
+		{
+			break;
+		}
+
+		hash = HashBytes(hash, buffer, (u_int32)count);
+		length -= count;
+	}
+
+	fsetpos(in, &pos);
+
+	return hash;
+}
+
+
+
+/*************************************************************************** 
+	Free an allocated OS9ROF structure along with its references. The
+	references to an external symbol follow each other and share its
+	name so it is only freed once.
 ***************************************************************************/
 void FreeROF(OS9ROF *rfile)
 {
-	if(NULL == rfile->objectCode)
+	Node *node;
+	char *lastSymbol;
+
+	if(NULL == rfile)
+	{
+		return;
+	}
+
+	if(NULL != rfile->refList)
 	{
-		free(rfile->objectCode);
-		rfile->objectCode = NULL;
+		lastSymbol = NULL;
+		node = NULL;
+		while(NULL != (node = NodeGetNext(rfile->refList, node)))
+		{
+			Reference *ref;
+
+			ref = NodeGetData(node);
+			if(NULL != ref->symbol && lastSymbol != ref->symbol)
+			{
+				MemFree(ref->symbol);
+				lastSymbol = ref->symbol;
+			}
+			MemFree(ref);
+		}
+		ListFree(rfile->refList);
 	}
+
+	MemFree(rfile->objectCode);
+	MemFree(rfile->initData);
+	MemFree(rfile->initDataDP);
+	MemFree(rfile->filename);
+	MemFree(rfile);
+}
+
+
+/*************************************************************************** 
+	Position the file at the next sync marker following a module that
+	failed to load.
+***************************************************************************/
+int SkipToNextROF(FILE *in, fpos_t start)
+{
+	u_int32 sync;
+	int c;
+
+	start++;
+	fsetpos(in, &start);
+
+	sync = 0;
+	while(EOF != (c = getc(in)))
+	{
+		sync = ((sync << 8) | c) & 0xffffffff;
+		if(ROFSYNC == sync)
+		{
+			fpos_t pos;
+
+			fgetpos(in, &pos);
+			pos -= 4;
+			fsetpos(in, &pos);
+
+			return ROF_OK;
+		}
+	}
+
+	return ROF_END;
 }
 
 
@@ -412,19 +716,64 @@ void FreeROF(OS9ROF *rfile)
 	Load a reolcatable object section from an opened file
 ***************************************************************************/
 int LoadROF(FILE *in, OS9ROF **retROF, const char *filename)
+{
+	ROFReader reader;
+
+	ReaderInitFile(&reader, in);
+
+	return LoadROFReader(&reader, retROF, filename);
+}
+
+
+/*************************************************************************** 
+	Name of the module the last failed load was reading. Empty when the
+	load failed before the header was read.
+***************************************************************************/
+static THREAD_LOCAL char failedName[256];
+
+const char *GetFailedROFName(void)
+{
+	return failedName;
+}
+
+
+/*************************************************************************** 
+	Load a relocatable object section from a reader. When reading from
+	memory the reader is left positioned after the module.
+***************************************************************************/
+int LoadROFReader(ROFReader *in, OS9ROF **retROF, const char *filename)
 {
 	int result;
 	OS9ROF *rfile;
 
 	*retROF = NULL;
+	failedName[0] = 0;
+
+	/* Start charging this module's budgets */
+	BudgetReset();
 
 	/* Allocate the struct */
-	rfile = calloc(1, sizeof(OS9ROF));
+	rfile = AllocModule(MEM_LOADER, sizeof(OS9ROF));
+	if(NULL == rfile)
+	{
+		return ROF_ERROR;
+	}
 
-	ListInit(&rfile->refList);
+	ListInit(&rfile->refList, MEM_REFERENCES);
+	if(NULL == rfile->refList)
+	{
+		SetError("out of memory");
+		FreeROF(rfile);
+		return ROF_ERROR;
+	}
 
 	/* Save the filename */
-	rfile->filename = malloc(strlen(filename) + 1);
+	rfile->filename = AllocModule(MEM_LOADER, strlen(filename) + 1);
+	if(NULL == rfile->filename)
+	{
+		FreeROF(rfile);
+		return ROF_ERROR;
+	}
 	strcpy(rfile->filename, filename);
 
 	/* Read the header */
@@ -444,16 +793,32 @@ int LoadROF(FILE *in, OS9ROF **retROF, const char *filename)
 		GetOffset(in, rfile, &rfile->offsetDPData);
 
 		/* Load direct page data */
-		rfile->initDataDP = malloc(rfile->sizeInitDPData);
-		fread(rfile->initDataDP, rfile->sizeInitDPData, 1, in);
+		rfile->initDataDP = AllocModule(MEM_LOADER, rfile->sizeInitDPData + MAXOPSIZE);
+		if(NULL == rfile->initDataDP)
+		{
+			result = ROF_ERROR;
+		}
+		else if(rfile->sizeInitDPData != ReaderRead(in, rfile->initDataDP, rfile->sizeInitDPData))
+		{
+			SetError("truncated direct page data");
+			result = ROF_ERROR;
+		}
 	}
 
 	if(0 == result && 0 != rfile->sizeInitData)
 	{
 		GetOffset(in, rfile, &rfile->offsetData);
 
-		rfile->initData = malloc(rfile->sizeInitData);
-		fread(rfile->initData, rfile->sizeInitData, 1, in);
+		rfile->initData = AllocModule(MEM_LOADER, rfile->sizeInitData + MAXOPSIZE);
+		if(NULL == rfile->initData)
+		{
+			result = ROF_ERROR;
+		}
+		else if(rfile->sizeInitData != ReaderRead(in, rfile->initData, rfile->sizeInitData))
+		{
+			SetError("truncated initialized data");
+			result = ROF_ERROR;
+		}
 	}
 
 
@@ -472,6 +837,8 @@ int LoadROF(FILE *in, OS9ROF **retROF, const char *filename)
 
 	if(0 != result)
 	{
+		/* Keep the name so the failure can still identify the module */
+		strcpy(failedName, rfile->name);
 		FreeROF(rfile);
 	}
 	else
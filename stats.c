@@ -0,0 +1,594 @@
+/*****************************************************************************
+	stats.c	- Timing and counters for the phases of a module
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Each thread collects into the stats it is attached to. The phases
+	nest, and the time spent in a nested phase is only charged to it so
+	the phases add up to the time of the module.
+
+	The timeline records when each thread begins and ends its work on
+	modules and phases so stalls between the threads can be seen. Every
+	thread logs into a buffer of its own and the buffers are only read
+	once the threads are done.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rof.h"
+#include "stats.h"
+#include "platform.h"
+
+#define MAX_PHASE_DEPTH	8		/* Most phases nested on one thread */
+#define MAX_TIMELINE_THREADS	1024	/* Threads recorded, later ones are left out */
+#define TIMELINE_CHUNK	1024	/* Events allocated at a time */
+
+typedef struct
+{
+	u_int32		time;		/* Microseconds since the timeline was enabled */
+	char		type;		/* B for begin or E for end */
+	char		name[35];	/* Module or phase that begins */
+} TimelineEvent;
+
+typedef struct _TimelineChunk
+{
+	struct _TimelineChunk	*next;
+	u_int32					count;		/* Events used in the chunk */
+	TimelineEvent			events[TIMELINE_CHUNK];
+} TimelineChunk;
+
+typedef struct
+{
+	char			name[32];	/* What the thread does */
+	TimelineChunk	*head;
+	TimelineChunk	*tail;		/* Chunk events are added to */
+} TimelineThread;
+
+THREAD_LOCAL PhaseStats *statsTarget = NULL;
+
+static THREAD_LOCAL PHASE phaseStack[MAX_PHASE_DEPTH];
+static THREAD_LOCAL int phaseDepth = 0;
+static THREAD_LOCAL unsigned long phaseWall;	/* Clocks when the current phase was last charged */
+static THREAD_LOCAL unsigned long phaseCpu;
+
+static BOOL timelineEnabled = FALSE;
+static unsigned long timelineStart;
+static TimelineThread *timelineThreads[MAX_TIMELINE_THREADS];
+static volatile long timelineThreadCount = 0;
+static THREAD_LOCAL TimelineThread *timelineThread = NULL;
+static THREAD_LOCAL BOOL timelineFull = FALSE;	/* Set when the thread can't record */
+
+static const char *phaseNames[PHASE_COUNT] =
+{
+	"LoadROF",
+	"TraceObjectCode",
+	"pass 1",
+	"pass 2",
+	"DisasmDumpData"
+};
+
+static const char *phaseKeys[PHASE_COUNT] = {"load", "trace", "pass1", "pass2", "data"};
+
+static const char *statNames[STAT_COUNT] =
+{
+	"bytes traced",
+	"offsets pre-decoded",
+	"instructions traced",
+	"instructions emitted",
+	"refList nodes",
+	"lines emitted",
+	"bytes emitted",
+	"allocations"
+};
+
+static const char *statKeys[STAT_COUNT] = {"traced", "predecoded", "tracedInsns", "emittedInsns", "refNodes", "lines", "bytes", "allocations"};
+
+static const char *memoryKeys[MEM_COUNT + 1] = {"loader", "references", "symbols", "output", "other", "total"};
+
+
+
+/*************************************************************************** 
+	Collect the stats of the current thread into stats, or stop
+	collecting them if it is NULL
+***************************************************************************/
+void StatsAttach(PhaseStats *stats)
+{
+	statsTarget = stats;
+	phaseDepth = 0;
+}
+
+
+/*************************************************************************** 
+	Charge the time since the last charge to the current phase
+***************************************************************************/
+static void ChargePhase(void)
+{
+	unsigned long wall;
+	unsigned long cpu;
+
+	wall = GetMicroseconds();
+	cpu = GetThreadCpuMicroseconds();
+
+	if(0 != phaseDepth)
+	{
+		statsTarget->wall[phaseStack[phaseDepth - 1]] += (wall - phaseWall) / 1000000.0;
+		statsTarget->cpu[phaseStack[phaseDepth - 1]] += (cpu - phaseCpu) / 1000000.0;
+	}
+
+	phaseWall = wall;
+	phaseCpu = cpu;
+}
+
+
+/*************************************************************************** 
+	Begin and end a phase on the current thread. The phases are also
+	recorded in the timeline.
+***************************************************************************/
+void StatsEnter(PHASE phase)
+{
+	TimelineBegin(phaseNames[phase]);
+
+	if(NULL == statsTarget)
+	{
+		return;
+	}
+
+	ChargePhase();
+
+	/* Phases nested too deeply are charged to the one they are in */
+	if(MAX_PHASE_DEPTH == phaseDepth)
+	{
+		phase = phaseStack[phaseDepth - 1];
+	}
+	else
+	{
+		phaseDepth++;
+	}
+	phaseStack[phaseDepth - 1] = phase;
+}
+
+
+void StatsLeave(void)
+{
+	TimelineEnd();
+
+	if(NULL == statsTarget || 0 == phaseDepth)
+	{
+		return;
+	}
+
+	ChargePhase();
+	phaseDepth--;
+}
+
+
+/*************************************************************************** 
+	Add the stats a worker thread collected for the module to the stats
+	of the current thread. The worker ran alongside this thread so only
+	its CPU time is added.
+***************************************************************************/
+void StatsMerge(const PhaseStats *stats)
+{
+	int index;
+
+	if(NULL == statsTarget)
+	{
+		return;
+	}
+
+	for(index = 0; index < PHASE_COUNT; index++)
+	{
+		statsTarget->cpu[index] += stats->cpu[index];
+	}
+
+	for(index = 0; index < STAT_COUNT; index++)
+	{
+		statsTarget->counts[index] += stats->counts[index];
+	}
+
+	/* The worker's memory was in use on top of what the module had */
+	for(index = 0; index <= MEM_TOTAL; index++)
+	{
+		MemoryStats *memory;
+
+		memory = &statsTarget->memory[index];
+		if(memory->live + stats->memory[index].peak > memory->peak)
+		{
+			memory->peak = memory->live + stats->memory[index].peak;
+		}
+		memory->allocs += stats->memory[index].allocs;
+		memory->bytes += stats->memory[index].bytes;
+		memory->live += stats->memory[index].live;
+	}
+}
+
+
+/*************************************************************************** 
+	Add the stats of a module to a total
+***************************************************************************/
+void StatsAdd(PhaseStats *total, const PhaseStats *stats)
+{
+	int index;
+
+	for(index = 0; index < PHASE_COUNT; index++)
+	{
+		total->wall[index] += stats->wall[index];
+		total->cpu[index] += stats->cpu[index];
+	}
+
+	for(index = 0; index < STAT_COUNT; index++)
+	{
+		total->counts[index] += stats->counts[index];
+	}
+
+	/* The peak of the total is that of the largest module */
+	for(index = 0; index <= MEM_TOTAL; index++)
+	{
+		total->memory[index].allocs += stats->memory[index].allocs;
+		total->memory[index].bytes += stats->memory[index].bytes;
+		total->memory[index].live += stats->memory[index].live;
+		if(stats->memory[index].peak > total->memory[index].peak)
+		{
+			total->memory[index].peak = stats->memory[index].peak;
+		}
+	}
+}
+
+
+/*************************************************************************** 
+	Print stats as a table of the phases followed by the counters
+***************************************************************************/
+void StatsPrint(FILE *outFile, const char *title, const PhaseStats *stats)
+{
+	double wall;
+	double cpu;
+	int index;
+
+	fprintf(outFile, "%s\n", title);
+	fprintf(outFile, "  %-22s%12s%12s\n", "phase", "wall ms", "cpu ms");
+
+	wall = 0;
+	cpu = 0;
+	for(index = 0; index < PHASE_COUNT; index++)
+	{
+		fprintf(outFile, "  %-22s%12.3f%12.3f\n", phaseNames[index], stats->wall[index] * 1000, stats->cpu[index] * 1000);
+		wall += stats->wall[index];
+		cpu += stats->cpu[index];
+	}
+	fprintf(outFile, "  %-22s%12.3f%12.3f\n", "total", wall * 1000, cpu * 1000);
+
+	for(index = 0; index < STAT_COUNT; index++)
+	{
+		fprintf(outFile, "  %-22s%12lu\n", statNames[index], (unsigned long)stats->counts[index]);
+	}
+
+	fprintf(outFile, "  %-22s%12s%12s%12s%12s\n", "memory", "allocs", "bytes", "live", "peak");
+	for(index = 0; index <= MEM_TOTAL; index++)
+	{
+		fprintf(outFile, "  %-22s%12lu%12lu%12ld%12ld\n",
+			memoryKeys[index],
+			(unsigned long)stats->memory[index].allocs,
+			(unsigned long)stats->memory[index].bytes,
+			stats->memory[index].live,
+			stats->memory[index].peak);
+	}
+}
+
+
+/*************************************************************************** 
+	Print a quoted and escaped JSON string
+***************************************************************************/
+void StatsPrintJsonString(FILE *outFile, const char *text)
+{
+	putc('"', outFile);
+	while(0 != *text)
+	{
+		u_char c;
+
+		c = (u_char)*text++;
+		if('"' == c || '\\' == c)
+		{
+			fprintf(outFile, "\\%c", c);
+		}
+		else if(c < 0x20)
+		{
+			fprintf(outFile, "\\u%04x", c);
+		}
+		else
+		{
+			putc(c, outFile);
+		}
+	}
+	putc('"', outFile);
+}
+
+
+/*************************************************************************** 
+	Print stats as one JSON record. The times are in milliseconds.
+***************************************************************************/
+void StatsPrintJson(FILE *outFile, const char *type, const char *source, const char *name, const PhaseStats *stats)
+{
+	int index;
+
+	fprintf(outFile, "{\"type\":\"%s\"", type);
+	if(NULL != source)
+	{
+		fprintf(outFile, ",\"source\":");
+		StatsPrintJsonString(outFile, source);
+	}
+	if(NULL != name)
+	{
+		fprintf(outFile, ",\"name\":");
+		StatsPrintJsonString(outFile, name);
+	}
+
+	fprintf(outFile, ",\"wall\":{");
+	for(index = 0; index < PHASE_COUNT; index++)
+	{
+		fprintf(outFile, "%s\"%s\":%.3f", 0 != index ? "," : "", phaseKeys[index], stats->wall[index] * 1000);
+	}
+
+	fprintf(outFile, "},\"cpu\":{");
+	for(index = 0; index < PHASE_COUNT; index++)
+	{
+		fprintf(outFile, "%s\"%s\":%.3f", 0 != index ? "," : "", phaseKeys[index], stats->cpu[index] * 1000);
+	}
+
+	fprintf(outFile, "},\"counts\":{");
+	for(index = 0; index < STAT_COUNT; index++)
+	{
+		fprintf(outFile, "%s\"%s\":%lu", 0 != index ? "," : "", statKeys[index], (unsigned long)stats->counts[index]);
+	}
+
+	fprintf(outFile, "},\"memory\":{");
+	for(index = 0; index <= MEM_TOTAL; index++)
+	{
+		fprintf(outFile, "%s\"%s\":{\"allocs\":%lu,\"bytes\":%lu,\"live\":%ld,\"peak\":%ld}",
+			0 != index ? "," : "",
+			memoryKeys[index],
+			(unsigned long)stats->memory[index].allocs,
+			(unsigned long)stats->memory[index].bytes,
+			stats->memory[index].live,
+			stats->memory[index].peak);
+	}
+
+	fprintf(outFile, "}}\n");
+}
+
+
+/*************************************************************************** 
+	Start recording the timeline. This has to be done before any thread
+	records to it.
+***************************************************************************/
+void TimelineEnable(void)
+{
+	timelineStart = GetMicroseconds();
+	timelineEnabled = TRUE;
+}
+
+
+/*************************************************************************** 
+	Get the buffer of the current thread, claiming a slot for it the
+	first time
+***************************************************************************/
+static TimelineThread *GetTimelineThread(void)
+{
+	TimelineThread *thread;
+	long slot;
+
+	if(NULL != timelineThread || TRUE == timelineFull)
+	{
+		return timelineThread;
+	}
+
+	thread = calloc(1, sizeof(TimelineThread));
+	slot = AtomicAdd(&timelineThreadCount, 1) - 1;
+	if(NULL == thread || slot >= MAX_TIMELINE_THREADS)
+	{
+		free(thread);
+		timelineFull = TRUE;
+		return NULL;
+	}
+
+	strcpy(thread->name, "thread");
+	timelineThreads[slot] = thread;
+	timelineThread = thread;
+
+	return thread;
+}
+
+
+/*************************************************************************** 
+	Name the current thread in the timeline
+***************************************************************************/
+void TimelineThreadName(const char *name)
+{
+	TimelineThread *thread;
+
+	if(FALSE == timelineEnabled || NULL == (thread = GetTimelineThread()))
+	{
+		return;
+	}
+
+	strncpy(thread->name, name, sizeof(thread->name) - 1);
+}
+
+
+static void AddTimelineEvent(char type, const char *name)
+{
+	TimelineThread *thread;
+	TimelineEvent *event;
+
+	thread = GetTimelineThread();
+	if(NULL == thread)
+	{
+		return;
+	}
+
+	if(NULL == thread->tail || TIMELINE_CHUNK == thread->tail->count)
+	{
+		TimelineChunk *chunk;
+
+		chunk = malloc(sizeof(TimelineChunk));
+		if(NULL == chunk)
+		{
+			return;
+		}
+		chunk->next = NULL;
+		chunk->count = 0;
+
+		if(NULL == thread->tail)
+		{
+			thread->head = chunk;
+		}
+		else
+		{
+			thread->tail->next = chunk;
+		}
+		thread->tail = chunk;
+	}
+
+	event = &thread->tail->events[thread->tail->count++];
+	event->time = (u_int32)(GetMicroseconds() - timelineStart);
+	event->type = type;
+	strncpy(event->name, name, sizeof(event->name) - 1);
+	event->name[sizeof(event->name) - 1] = 0;
+}
+
+
+/*************************************************************************** 
+	Record the beginning and end of a module or phase on the current
+	thread. Ends match the last begin that is still open.
+***************************************************************************/
+void TimelineBegin(const char *name)
+{
+	if(TRUE == timelineEnabled)
+	{
+		AddTimelineEvent('B', name);
+	}
+}
+
+
+void TimelineEnd(void)
+{
+	if(TRUE == timelineEnabled)
+	{
+		AddTimelineEvent('E', "");
+	}
+}
+
+
+/*************************************************************************** 
+	Write the timeline as Chrome trace events and free it. Every thread
+	that recorded has to be done.
+***************************************************************************/
+int TimelineWrite(const char *filename)
+{
+	FILE *outFile;
+	const char *separator;
+	long count;
+	long index;
+
+	outFile = fopen(filename, "w");
+	if(NULL == outFile)
+	{
+		SetError("can't create '%s'", filename);
+		return -1;
+	}
+
+	count = timelineThreadCount < MAX_TIMELINE_THREADS ? timelineThreadCount : MAX_TIMELINE_THREADS;
+	separator = "\n";
+
+	fprintf(outFile, "{\"traceEvents\":[");
+	for(index = 0; index < count; index++)
+	{
+		TimelineThread *thread;
+		TimelineChunk *chunk;
+
+		thread = timelineThreads[index];
+		if(NULL == thread)
+		{
+			continue;
+		}
+
+		fprintf(outFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%ld,\"args\":{\"name\":", separator, index + 1);
+		StatsPrintJsonString(outFile, thread->name);
+		fprintf(outFile, "}}");
+		separator = ",\n";
+
+		while(NULL != (chunk = thread->head))
+		{
+			u_int32 event;
+
+			for(event = 0; event < chunk->count; event++)
+			{
+				fprintf(outFile, ",\n{");
+				if('B' == chunk->events[event].type)
+				{
+					fprintf(outFile, "\"name\":");
+					StatsPrintJsonString(outFile, chunk->events[event].name);
+					fprintf(outFile, ",");
+				}
+				fprintf(outFile, "\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%ld}",
+					chunk->events[event].type,
+					(unsigned long)chunk->events[event].time,
+					index + 1);
+			}
+
+			thread->head = chunk->next;
+			free(chunk);
+		}
+
+		free(thread);
+		timelineThreads[index] = NULL;
+	}
+	fprintf(outFile, "\n]}\n");
+
+	timelineEnabled = FALSE;
+	timelineThreadCount = 0;
+
+	if(0 != ferror(outFile))
+	{
+		fclose(outFile);
+		SetError("error writing '%s'", filename);
+		return -1;
+	}
+	fclose(outFile);
+
+	return 0;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
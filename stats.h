@@ -0,0 +1,109 @@
+/*****************************************************************************
+	stats.h	- Timing and counters for the phases of a module
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include "util.h"
+
+typedef enum
+{
+	PHASE_LOAD,			/* LoadROF */
+	PHASE_TRACE,		/* TraceObjectCode or SweepObjectCode */
+	PHASE_PASS1,		/* First pass and line index */
+	PHASE_PASS2,		/* Listing, without the data */
+	PHASE_DATA,			/* DisasmDumpData */
+	PHASE_COUNT
+} PHASE;
+
+typedef enum
+{
+	STAT_TRACED,		/* Bytes of code marked by the trace */
+	STAT_PREDECODED,	/* Code offsets decoded into steps before the trace */
+	STAT_TRACED_INSNS,	/* Instructions the trace first marked as code */
+	STAT_EMITTED_INSNS,	/* Instructions written to the listing */
+	STAT_REFNODES,		/* Nodes of the reference list visited */
+	STAT_LINES,			/* Lines of output */
+	STAT_BYTES,			/* Bytes of output */
+	STAT_ALLOCS,		/* Memory allocations */
+	STAT_COUNT
+} STAT;
+
+/* Memory of a pool, MEM_TOTAL holds all of the pools together */
+#define MEM_TOTAL	MEM_COUNT
+
+typedef struct
+{
+	u_int32		allocs;		/* Allocations and reallocations */
+	u_int32		bytes;		/* Bytes allocated */
+	long		live;		/* Bytes allocated and not yet freed */
+	long		peak;		/* Most bytes live at once */
+} MemoryStats;
+
+typedef struct
+{
+	double		wall[PHASE_COUNT];	/* Elapsed seconds in each phase */
+	double		cpu[PHASE_COUNT];	/* Thread CPU seconds in each phase */
+	u_int32		counts[STAT_COUNT];
+	MemoryStats	memory[MEM_COUNT + 1];
+} PhaseStats;
+
+/* Stats of the current thread, NULL when they aren't collected */
+extern THREAD_LOCAL PhaseStats *statsTarget;
+
+#define STATS_COUNT(stat, amount)	if(NULL != statsTarget) statsTarget->counts[stat] += (amount)
+
+void StatsAttach(PhaseStats *stats);
+void StatsEnter(PHASE phase);
+void StatsLeave(void);
+void StatsMerge(const PhaseStats *stats);
+void StatsAdd(PhaseStats *total, const PhaseStats *stats);
+void StatsPrint(FILE *outFile, const char *title, const PhaseStats *stats);
+void StatsPrintJson(FILE *outFile, const char *type, const char *source, const char *name, const PhaseStats *stats);
+void StatsPrintJsonString(FILE *outFile, const char *text);
+
+void MemGetTotals(MemoryStats *totals);
+
+void TimelineEnable(void);
+void TimelineThreadName(const char *name);
+void TimelineBegin(const char *name);
+void TimelineEnd(void);
+int TimelineWrite(const char *filename);
+
+#endif	/* STATS_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
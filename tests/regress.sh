@@ -0,0 +1,92 @@
+#!/bin/sh
+#
+#	regress.sh	- Regression checks of the disassembler
+#
+#	usage: tests/regress.sh <bindir>
+#
+#	<bindir> holds kdisasm, rofgen and ktest. For every seed in trace.sum
+#	a library of generated modules is disassembled and checked that
+#
+#	- the listing has the checksum recorded before the trace went over
+#	  the step table
+#	- rendering on several threads gives the same bytes as one thread
+#	- the listing KDisasmSetHints updates matches one made from scratch
+#	  for each of the edit hints files in turn
+#
+#	and that hints files with overlong or malformed lines stop the run
+#	with a short error instead of crashing.
+#
+#	Exits with the number of failed checks.
+#
+
+if [ $# -ne 1 ]; then
+	echo "usage: $0 <bindir>" >&2
+	exit 1
+fi
+
+bin=$1
+tests=$(dirname "$0")
+work=${TMPDIR:-/tmp}/kdisasm-regress.$$
+failed=0
+
+mkdir -p "$work" || exit 1
+trap 'rm -rf "$work"' EXIT
+
+fail()
+{
+	echo "FAIL: $*" >&2
+	failed=$((failed + 1))
+}
+
+while read seed sum size; do
+	case "$seed" in
+		''|'#'*) continue ;;
+	esac
+
+	lib=$work/seed$seed.l
+	if ! "$bin/rofgen" --modules 3 --code 16k --seed "$seed" "$lib" >/dev/null 2>&1; then
+		fail "rofgen seed $seed"
+		continue
+	fi
+
+	"$bin/kdisasm" "$lib" >"$work/serial.txt" 2>/dev/null || fail "kdisasm seed $seed"
+
+	set -- $(cksum <"$work/serial.txt")
+	if [ "$1" != "$sum" ] || [ "$2" != "$size" ]; then
+		fail "seed $seed listing is $1 $2, expected $sum $size"
+	fi
+
+	for threads in 2 4 8; do
+		"$bin/kdisasm" --render-threads $threads "$lib" >"$work/parallel.txt" 2>/dev/null
+		cmp -s "$work/serial.txt" "$work/parallel.txt" || fail "seed $seed differs on $threads render threads"
+	done
+
+	"$bin/ktest" "$lib" "$tests/edit1.hints" "$tests/edit2.hints" "$tests/edit3.hints" >/dev/null \
+		|| fail "seed $seed listing updated from hints differs"
+done <"$tests/trace.sum"
+
+# The error names the file and line and the token is cut short
+"$bin/rofgen" --seed 1 "$work/bad.l" >/dev/null 2>&1
+for hints in overlong.hints:3 malformed.hints; do
+	file=${hints%%:*}
+	where=$file
+	case "$hints" in
+		*:*) where="$file(${hints#*:})" ;;
+	esac
+
+	"$bin/kdisasm" --hints "$tests/$file" "$work/bad.l" >/dev/null 2>"$work/error.txt"
+	status=$?
+	if [ $status -ne 1 ]; then
+		fail "$file exits with $status, expected 1"
+	elif ! grep -q "$where: " "$work/error.txt"; then
+		fail "$file error does not name $where"
+	elif [ $(wc -c <"$work/error.txt") -gt 256 ]; then
+		fail "$file error is not cut short"
+	fi
+done
+
+if [ $failed -eq 0 ]; then
+	echo "regress: all checks passed"
+fi
+
+exit $failed
@@ -0,0 +1,186 @@
+/*****************************************************************************
+	textbuf.c	- Growable text buffer for generated output
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "textbuf.h"
+
+#define TEXTBUF_MINSIZE		4096
+
+
+
+/*************************************************************************** 
+***************************************************************************/
+void TextBufInit(TextBuf *buf)
+{
+	buf->text = NULL;
+	buf->length = 0;
+	buf->size = 0;
+}
+
+
+void TextBufFree(TextBuf *buf)
+{
+	MemFree(buf->text);
+	TextBufInit(buf);
+}
+
+
+void TextBufReset(TextBuf *buf)
+{
+	buf->length = 0;
+	if(NULL != buf->text)
+	{
+		buf->text[0] = 0;
+	}
+}
+
+
+/*************************************************************************** 
+	Make sure there is room for count more characters plus the terminator
+***************************************************************************/
+static int TextBufReserve(TextBuf *buf, u_int32 count)
+{
+	u_int32 size;
+	char *text;
+
+	if(buf->length + count < buf->size)
+	{
+		return 0;
+	}
+
+	size = buf->size < TEXTBUF_MINSIZE ? TEXTBUF_MINSIZE : buf->size;
+	while(size <= buf->length + count)
+	{
+		size *= 2;
+	}
+
+	text = MemRealloc(MEM_OUTPUT, buf->text, size);
+	if(NULL == text)
+	{
+		return -1;
+	}
+
+	buf->text = text;
+	buf->size = size;
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+***************************************************************************/
+int TextBufWrite(TextBuf *buf, const char *text, u_int32 length)
+{
+	if(0 != TextBufReserve(buf, length))
+	{
+		return -1;
+	}
+
+	memcpy(buf->text + buf->length, text, length);
+	buf->length += length;
+	buf->text[buf->length] = 0;
+
+	return (int)length;
+}
+
+
+int TextBufVPrintf(TextBuf *buf, const char *fmt, va_list args)
+{
+	va_list copy;
+	int length;
+
+	/* Most output is short so try to format it in place first */
+	if(0 != TextBufReserve(buf, 128))
+	{
+		return -1;
+	}
+
+	va_copy(copy, args);
+	length = vsnprintf(buf->text + buf->length, buf->size - buf->length, fmt, copy);
+	va_end(copy);
+
+	if(length < 0)
+	{
+		return -1;
+	}
+
+	if((u_int32)length >= buf->size - buf->length)
+	{
+		if(0 != TextBufReserve(buf, length))
+		{
+			return -1;
+		}
+
+		va_copy(copy, args);
+		vsnprintf(buf->text + buf->length, buf->size - buf->length, fmt, copy);
+		va_end(copy);
+	}
+
+	buf->length += length;
+
+	return length;
+}
+
+
+/*************************************************************************** 
+	Replace the characters from start up to but not including end with
+	length characters of text
+***************************************************************************/
+int TextBufReplace(TextBuf *buf, u_int32 start, u_int32 end, const char *text, u_int32 length)
+{
+	u_int32 removed;
+
+	removed = end - start;
+	if(length > removed && 0 != TextBufReserve(buf, length - removed))
+	{
+		return -1;
+	}
+
+	if(NULL == buf->text)
+	{
+		return 0;
+	}
+
+	memmove(buf->text + start + length, buf->text + end, buf->length - end + 1);
+	memcpy(buf->text + start, text, length);
+	buf->length = buf->length - removed + length;
+
+	return 0;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,59 @@
+/*****************************************************************************
+	textbuf.h	- Growable text buffer for generated output
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#ifndef TEXTBUF_H
+#define TEXTBUF_H
+
+#include <stdarg.h>
+#include "util.h"
+
+typedef struct
+{
+	char		*text;		/* Generated text, always null terminated */
+	u_int32		length;		/* Number of characters in the buffer */
+	u_int32		size;		/* Allocated size of the buffer */
+} TextBuf;
+
+void TextBufInit(TextBuf *buf);
+void TextBufFree(TextBuf *buf);
+void TextBufReset(TextBuf *buf);
+int TextBufWrite(TextBuf *buf, const char *text, u_int32 length);
+int TextBufVPrintf(TextBuf *buf, const char *fmt, va_list args);
+int TextBufReplace(TextBuf *buf, u_int32 start, u_int32 end, const char *text, u_int32 length);
+
+#endif	/* TEXTBUF_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
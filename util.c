@@ -12,6 +12,11 @@
 #include <stdarg.h>
 #include <assert.h>
 #include "rof.h"
+#include "genasm.h"
+#include "platform.h"
+#include "stats.h"
+
+#define BUDGET_TIMECHECK	256		/* Instructions between checks of the clock */
 
 
 
@@ -37,34 +42,138 @@ void ferr(const char *s)
 }
 
 
+/*************************************************************************** 
+	Record why the current module failed. Unlike error() this does not
+	terminate so the caller can skip the module and carry on.
+***************************************************************************/
+static THREAD_LOCAL char errorText[256];
+
+void SetError(const char *fmt, ...)
+{
+	va_list start;
+
+	/* Names in the message come from the input so the text is cut short */
+	va_start(start, fmt);
+#if defined(_MSC_VER) && _MSC_VER < 1900
+	_vsnprintf(errorText, sizeof(errorText) - 1, fmt, start);
+	errorText[sizeof(errorText) - 1] = 0;
+#else
+	vsnprintf(errorText, sizeof(errorText), fmt, start);
+#endif
+	va_end(start);
+}
+
+
+const char *GetErrorText(void)
+{
+	return errorText;
+}
+
+
+/*************************************************************************** 
+	Per module budgets. A zero limit means there is no limit.
+***************************************************************************/
+static ModuleLimits limits;
+static THREAD_LOCAL u_int32 budgetStart;
+static THREAD_LOCAL u_int32 budgetRefs;
+static THREAD_LOCAL u_int32 budgetInsns;
+static THREAD_LOCAL u_int32 budgetMemory;
+
+void SetModuleLimits(const ModuleLimits *newLimits)
+{
+	limits = *newLimits;
+}
+
+
+void BudgetReset(void)
+{
+	budgetStart = GetMilliseconds();
+	budgetRefs = 0;
+	budgetInsns = 0;
+	budgetMemory = 0;
+}
+
+
+int BudgetReference(void)
+{
+	budgetRefs++;
+	if(0 != limits.maxRefs && budgetRefs > limits.maxRefs)
+	{
+		SetError("reference limit of %lu exceeded", (unsigned long)limits.maxRefs);
+		return -1;
+	}
+
+	return 0;
+}
+
+
+int BudgetMemory(u_int32 size)
+{
+	budgetMemory += size;
+	if(0 != limits.maxMemory && budgetMemory > limits.maxMemory)
+	{
+		SetError("memory limit of %lu bytes exceeded", (unsigned long)limits.maxMemory);
+		return -1;
+	}
+
+	return 0;
+}
+
+
+int BudgetInstructions(u_int32 count)
+{
+	u_int32 last;
+
+	last = budgetInsns;
+	budgetInsns += count;
+	if(0 != limits.maxInsns && budgetInsns > limits.maxInsns)
+	{
+		SetError("instruction limit of %lu exceeded", (unsigned long)limits.maxInsns);
+		return -1;
+	}
+
+	/* Only look at the clock every so often */
+	if(0 != limits.maxTime && (last / BUDGET_TIMECHECK) != (budgetInsns / BUDGET_TIMECHECK))
+	{
+		if(GetMilliseconds() - budgetStart > limits.maxTime)
+		{
+			SetError("time limit of %lu ms exceeded", (unsigned long)limits.maxTime);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+
 /*************************************************************************** 
 
 ***************************************************************************/
-void read8(FILE *file, u_char *val)
+void read8(ROFReader *in, u_char *val)
 {
-	*val = fgetc(file);
+	*val = ReaderGetc(in);
 }
 
 
-void read16(FILE *file, u_int16 *retVal)
+void read16(ROFReader *in, u_int16 *retVal)
 {
 	u_int16 val;
 
-	val = (fgetc(file) << 8);
-	val |= fgetc(file);
+	val = (ReaderGetc(in) << 8);
+	val |= ReaderGetc(in);
 
 	*retVal = val;
 }
 
 
-void read32(FILE *file, u_int32 *retVal)
+void read32(ROFReader *in, u_int32 *retVal)
 {
 	u_int32 val;
 
-	val = (fgetc(file) << 24);
-	val |= (fgetc(file) << 16);
-	val |= (fgetc(file) << 8);
-	val |= fgetc(file);
+	val = (ReaderGetc(in) << 24);
+	val |= (ReaderGetc(in) << 16);
+	val |= (ReaderGetc(in) << 8);
+	val |= ReaderGetc(in);
 
 	*retVal = val;
 }
@@ -72,58 +181,98 @@ void read32(FILE *file, u_int32 *retVal)
 
 
 
+/*************************************************************************** 
+	FNV-1a hash used to detect changed modules and output
+***************************************************************************/
+u_int32 HashBytes(u_int32 hash, const u_char *data, u_int32 length)
+{
+	while(length--)
+	{
+		hash ^= *(data++);
+		hash = (hash * 0x01000193) & 0xffffffff;
+	}
+
+	return hash;
+}
+
+
+u_int32 HashFile(const char *filename)
+{
+	FILE *file;
+	u_char buffer[4096];
+	u_int32 hash;
+	size_t count;
+
+	file = fopen(filename, "rb");
+	if(NULL == file)
+	{
+		return 0;
+	}
+
+	hash = HASH_INIT;
+	while(0 != (count = fread(buffer, 1, sizeof(buffer), file)))
+	{
+		hash = HashBytes(hash, buffer, (u_int32)count);
+	}
+
+	fclose(file);
+
+	return hash;
+}
+
+
 /*************************************************************************** 
 
 ***************************************************************************/
 static void ftext(FILE *outFile, u_char flag, int16 ref, REFTYPE type)
 {
-	fprintf(outFile, "[%02x : %04X] ", flag, ref);
+	GenText(outFile, "[%02x : %04X] ", flag, ref);
 
 	if(REF_GLOBAL != type)
 	/*if(flag & LOCMASK)*/
 	{
-		fprintf(outFile, flag & F_BYTE ? "byte" : "word");
-		fprintf(outFile, " ");
+		GenText(outFile, flag & F_BYTE ? "byte" : "word");
+		GenText(outFile, " ");
 
 		if(flag & CODLOC)
 		{
-			fprintf(outFile, "in code");
+			GenText(outFile, "in code");
 		}
 		else
 		{
-			fprintf(outFile, "in ");
+			GenText(outFile, "in ");
 			if(flag & DIRLOC)
 			{
-				fprintf(outFile, "direct page");
+				GenText(outFile, "direct page");
 			}
-			fprintf(outFile, "data");
+			GenText(outFile, "data");
 		}
 
-		fprintf(outFile, " ");
+		GenText(outFile, " ");
 
 		if(flag & (F_NEGATE | F_RELATIVE))
 		{
-			fprintf(outFile, "(");
+			GenText(outFile, "(");
 			
 			switch(flag & (F_NEGATE  | F_RELATIVE))
 			{
 			case F_NEGATE:
-				fprintf(outFile, "negative");
+				GenText(outFile, "negative");
 				break;
 			case F_RELATIVE:
-				fprintf(outFile, "offset pcr");
+				GenText(outFile, "offset pcr");
 				break;
 			case F_NEGATE  | F_RELATIVE:
-				fprintf(outFile, "negate offset to pcr");
+				GenText(outFile, "negate offset to pcr");
 				break;
 			}
-			fprintf(outFile, ") ");
+			GenText(outFile, ") ");
 		}
 	}
 
 	if(flag & CODENT)
 	{
-		fprintf(outFile, "references code");
+		GenText(outFile, "references code");
 	}
 
 	//CODENT	2	The reference refers to code
@@ -132,26 +281,26 @@ static void ftext(FILE *outFile, u_char flag, int16 ref, REFTYPE type)
 
 	if(REF_LOCAL == type)
 	{
-		fprintf(outFile, "referencing ");
+		GenText(outFile, "referencing ");
 
 		if(flag & DIRENT)
 		{
-			fprintf(outFile, "direct page ");
+			GenText(outFile, "direct page ");
 		}
 
 		if(flag & CODENT)
 		{
-			fprintf(outFile, "code ");
+			GenText(outFile, "code ");
 		}
 		else
 		{
 			if(flag & INIENT)
 			{
-				fprintf(outFile, "data ");
+				GenText(outFile, "data ");
 			}
 			else
 			{
-				fprintf(outFile, "bss ");
+				GenText(outFile, "bss ");
 			}
 		}
 	}
@@ -162,20 +311,20 @@ static void ftext(FILE *outFile, u_char flag, int16 ref, REFTYPE type)
 
 	if(REF_LOCAL == type)
 	{
-		fprintf(outFile, "referencing ");
+		GenText(outFile, "referencing ");
 
 		if(flag & (DIRENT | INIENT))
 		{
-			fprintf(outFile, flag & INIENT ? "data" : "bss");
+			GenText(outFile, flag & INIENT ? "data" : "bss");
 
 			if(flag & DIRENT)
 			{
-				fprintf(outFile, " in direct page");
+				GenText(outFile, " in direct page");
 			}
 		}
 		else if(flag & CODENT)
 		{
-			fprintf(outFile, "code");
+			GenText(outFile, "code");
 		} else
 		{
 		}
@@ -202,6 +351,7 @@ static void DumpReferences(FILE *outFile, OS9ROF *rfile, REFTYPE type)
 			count++;
 		}
 		node = NodeGetNext(rfile->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
 	}
 
 	if(0 == count)
@@ -212,19 +362,19 @@ static void DumpReferences(FILE *outFile, OS9ROF *rfile, REFTYPE type)
 	switch(type)
 	{
 	case REF_GLOBAL:
-		fprintf(outFile, "* Global");
+		GenText(outFile, "* Global");
 		break;
 	case REF_EXTERNAL:
-		fprintf(outFile, "* External");
+		GenText(outFile, "* External");
 		break;
 	case REF_LOCAL:
-		fprintf(outFile, "* Local");
+		GenText(outFile, "* Local");
 		break;
 	default:
 		assert(0);
 	}
 
-	fprintf(outFile, " references:\n");
+	GenText(outFile, " references:\n");
 
 	node = ListGetHead(rfile->refList);
 	while(NULL != node)
@@ -235,52 +385,53 @@ static void DumpReferences(FILE *outFile, OS9ROF *rfile, REFTYPE type)
 
 		if(type == ref->type)
 		{
-			fprintf(outFile, "*  ");
+			GenText(outFile, "*  ");
 			if(NULL != ref->symbol)
 			{
-				fprintf(outFile, "%9s:", ref->symbol);
+				GenText(outFile, "%9s:", ref->symbol);
 			}
 			else
 			{
-				fprintf(outFile, "          ");
+				GenText(outFile, "          ");
 			}
 
-			fprintf(outFile, "  ");
+			GenText(outFile, "  ");
 			ftext(outFile, ref->flag, ref->offset, type);
-			fprintf(outFile, "\n");
+			GenText(outFile, "\n");
 		}
 
 		node = NodeGetNext(rfile->refList, node);
+		STATS_COUNT(STAT_REFNODES, 1);
 	}
-	fprintf(outFile, "*\n");
+	GenText(outFile, "*\n");
 }
 
 void DumpROFInfo(FILE *outFile, OS9ROF *rof)
 {
 	/* Print header information */
-	fprintf(outFile, "************************************************************\n");
-	fprintf(outFile, "* Module name: %s\t", rof->name);
-	fprintf(outFile, "*   TyLa/RvAt: %02x/%02x\n", rof->typeLanguage >> 8, rof->typeLanguage);
-	fprintf(outFile, "*   Asm valid: %s\n", rof->asmVaild ? "No" : "Yes");
-	fprintf(outFile, "* Create date: %02d/%02d/%04d %02d:%02d\n", rof->creationDate[1],
+	GenText(outFile, "************************************************************\n");
+	GenText(outFile, "* Module name: %s\t", rof->name);
+	GenText(outFile, "*   TyLa/RvAt: %02x/%02x\n", rof->typeLanguage >> 8, rof->typeLanguage);
+	GenText(outFile, "*   Asm valid: %s\n", rof->asmVaild ? "No" : "Yes");
+	GenText(outFile, "* Create date: %02d/%02d/%04d %02d:%02d\n", rof->creationDate[1],
 													  rof->creationDate[2],
 													  rof->creationDate[0] + 1900,
 													  rof->creationDate[3],
 													  rof->creationDate[4]);
-	fprintf(outFile, "*     Edition: %2d\n",rof->edition);
-	fprintf(outFile, "*     Section: Init Uninit\n");
-	fprintf(outFile, "*        Code: %04x\n",rof->sizeObjectCode);
-	fprintf(outFile, "*          DP: %04x %04x\n",rof->sizeInitDPData, rof->sizeUninitDPData);
-	fprintf(outFile, "*        Data: %04x %04x\n",rof->sizeInitData, rof->sizeUninitData);
-	fprintf(outFile, "*       Stack: %04x\n",rof->sizeStack);
-	fprintf(outFile, "* Entry point: %04x\n",rof->execEntry);
-	fprintf(outFile, "************************************************************\n");
-
-	fprintf(outFile, "*\n");
+	GenText(outFile, "*     Edition: %2d\n",rof->edition);
+	GenText(outFile, "*     Section: Init Uninit\n");
+	GenText(outFile, "*        Code: %04x\n",rof->sizeObjectCode);
+	GenText(outFile, "*          DP: %04x %04x\n",rof->sizeInitDPData, rof->sizeUninitDPData);
+	GenText(outFile, "*        Data: %04x %04x\n",rof->sizeInitData, rof->sizeUninitData);
+	GenText(outFile, "*       Stack: %04x\n",rof->sizeStack);
+	GenText(outFile, "* Entry point: %04x\n",rof->execEntry);
+	GenText(outFile, "************************************************************\n");
+
+	GenText(outFile, "*\n");
 	DumpReferences(outFile, rof, REF_GLOBAL);
 	DumpReferences(outFile, rof, REF_EXTERNAL);
 	DumpReferences(outFile, rof, REF_LOCAL);
-	fprintf(outFile, "************************************************************\n");
+	GenText(outFile, "************************************************************\n");
 }
 
 
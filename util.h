@@ -16,16 +16,38 @@ typedef enum
 	TRUE
 } BOOL;
 
+#ifdef _MSC_VER
+#define THREAD_LOCAL	__declspec(thread)
+#else
+#define THREAD_LOCAL	__thread
+#endif
+
 typedef unsigned char u_char;
 typedef unsigned long u_int32;
 typedef unsigned short u_int16;
 typedef short int16;
 
 
+/* Subsystems that memory is charged to */
+typedef enum
+{
+	MEM_LOADER,			/* Module structures, code, and data */
+	MEM_REFERENCES,		/* References and the lists holding them */
+	MEM_SYMBOLS,		/* Symbol names */
+	MEM_OUTPUT,			/* Rendered text and output tables */
+	MEM_OTHER,			/* Hints, trace buffers, and the rest */
+	MEM_COUNT
+} MEMPOOL;
+
+void *MemAlloc(MEMPOOL pool, u_int32 size);
+void *MemRealloc(MEMPOOL pool, void *mem, u_int32 size);
+void MemFree(void *mem);
+
 typedef struct _Node Node;
 typedef struct _List List;
 
-void ListInit(List **list);
+void ListInit(List **list, MEMPOOL pool);
+void ListFree(List *list);
 void *ListAddTail(List *list, void *data);
 u_int32 ListGetSize(List *list);
 Node *ListGetHead(List *list);
@@ -33,6 +55,11 @@ Node *ListGetHead(List *list);
 void *NodeGetData(Node *node);
 Node *NodeGetNext(List *list, Node *node);
 
+#define HASH_INIT	0x811c9dc5		/* FNV-1a offset basis */
+
+u_int32 HashBytes(u_int32 hash, const u_char *data, u_int32 length);
+u_int32 HashFile(const char *filename);
+
 #endif	/* UTIL_H */
 
 
@@ -0,0 +1,234 @@
+/*****************************************************************************
+	watch.c	- Waits for changes to the directories holding the source files
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	The watch only tells the caller that something in one of the watched
+	directories changed. It is up to the caller to check which source
+	files were actually modified.
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#else
+#include <unistd.h>
+#endif
+#include "watch.h"
+
+#define MAX_WATCHDIRS	64
+#define WATCH_DEBOUNCE	100		/* Milliseconds to let writers finish */
+#define WATCH_POLL		500		/* Poll interval when no notification is available */
+
+static char *watchDirs[MAX_WATCHDIRS];
+static int watchCount = 0;
+
+#ifdef _WIN32
+static HANDLE watchHandles[MAX_WATCHDIRS];
+#elif defined(__linux__)
+static int watchFd = -1;
+#endif
+
+
+/*************************************************************************** 
+	Add the directory containing a file to the watch list
+***************************************************************************/
+static void AddWatchDir(const char *file)
+{
+	char *dir;
+	char *sep;
+	int i;
+
+	dir = malloc(strlen(file) + 2);
+	if(NULL == dir)
+	{
+		return;
+	}
+	strcpy(dir, file);
+
+	sep = strrchr(dir, '/');
+	if(NULL == sep)
+	{
+		sep = strrchr(dir, '\\');
+	}
+
+	if(NULL == sep)
+	{
+		strcpy(dir, ".");
+	}
+	else if(sep == dir)
+	{
+		sep[1] = 0;
+	}
+	else
+	{
+		*sep = 0;
+	}
+
+	for(i = 0; i < watchCount; i++)
+	{
+		if(0 == strcmp(watchDirs[i], dir))
+		{
+			free(dir);
+			return;
+		}
+	}
+
+	if(MAX_WATCHDIRS == watchCount)
+	{
+		free(dir);
+		return;
+	}
+
+	watchDirs[watchCount++] = dir;
+}
+
+
+/*************************************************************************** 
+	Start watching the directories of all source files
+***************************************************************************/
+int WatchInit(const char **files, int count)
+{
+	int i;
+
+	for(i = 0; i < count; i++)
+	{
+		AddWatchDir(files[i]);
+	}
+
+#ifdef _WIN32
+	for(i = 0; i < watchCount; i++)
+	{
+		watchHandles[i] = FindFirstChangeNotificationA(watchDirs[i],
+			FALSE,
+			FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+		if(INVALID_HANDLE_VALUE == watchHandles[i])
+		{
+			return -1;
+		}
+	}
+#elif defined(__linux__)
+	watchFd = inotify_init1(IN_CLOEXEC);
+	if(watchFd < 0)
+	{
+		return -1;
+	}
+
+	for(i = 0; i < watchCount; i++)
+	{
+		if(inotify_add_watch(watchFd, watchDirs[i], IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+		{
+			return -1;
+		}
+	}
+#endif
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Block until something changes in one of the watched directories
+***************************************************************************/
+int WatchWait(void)
+{
+#ifdef _WIN32
+	DWORD result;
+
+	result = WaitForMultipleObjects(watchCount, watchHandles, FALSE, INFINITE);
+	if(result >= WAIT_OBJECT_0 + watchCount)
+	{
+		return -1;
+	}
+
+	/* Give the compiler time to finish writing before we look */
+	Sleep(WATCH_DEBOUNCE);
+	FindNextChangeNotification(watchHandles[result - WAIT_OBJECT_0]);
+#elif defined(__linux__)
+	char events[4096];
+	struct pollfd pfd;
+
+	if(read(watchFd, events, sizeof(events)) <= 0)
+	{
+		return -1;
+	}
+
+	/* Drain anything that arrives while the writer finishes up */
+	usleep(WATCH_DEBOUNCE * 1000);
+
+	pfd.fd = watchFd;
+	pfd.events = POLLIN;
+	while(poll(&pfd, 1, 0) > 0 && read(watchFd, events, sizeof(events)) > 0);
+#else
+	usleep(WATCH_POLL * 1000);
+#endif
+
+	return 0;
+}
+
+
+/*************************************************************************** 
+	Release the watch handles
+***************************************************************************/
+void WatchClose(void)
+{
+	int i;
+
+	for(i = 0; i < watchCount; i++)
+	{
+#ifdef _WIN32
+		FindCloseChangeNotification(watchHandles[i]);
+#endif
+		free(watchDirs[i]);
+	}
+
+#ifdef __linux__
+	if(watchFd >= 0)
+	{
+		close(watchFd);
+		watchFd = -1;
+	}
+#endif
+
+	watchCount = 0;
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
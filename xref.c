@@ -0,0 +1,246 @@
+/*****************************************************************************
+	xref.c	- Cross reference table of disassembled modules
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+	--------------------------------------------------------------------------
+
+	Lists every address referenced by an operand along with the
+	instructions that reference it, grouped by the kind of reference:
+
+	* Label      Kind      Target  Referenced from
+	L000E        code      $000E   $0002 $0010
+
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xref.h"
+
+#define INITIAL_ENTRIES	256		/* Entries allocated when the table is first used */
+#define FROM_PER_LINE	8		/* Referencing addresses listed per line */
+
+
+static const char *kindNames[] =
+{
+	"none",
+	"code",
+	"data",
+	"bss",
+	"external",
+	"absolute"
+};
+
+
+static int CompareEntries(const void *left, const void *right)
+{
+	const XrefEntry *a;
+	const XrefEntry *b;
+
+	a = left;
+	b = right;
+
+	if(a->kind != b->kind)
+	{
+		return a->kind < b->kind ? -1 : 1;
+	}
+
+	if(a->target != b->target)
+	{
+		return a->target < b->target ? -1 : 1;
+	}
+
+	/* External references all target 0 so the label tells them apart */
+	if(ASMREF_EXTERNAL == a->kind)
+	{
+		int result;
+
+		result = strcmp(a->label, b->label);
+		if(0 != result)
+		{
+			return result;
+		}
+	}
+
+	return a->from < b->from ? -1 : (a->from > b->from ? 1 : 0);
+}
+
+
+static BOOL SameTarget(const XrefEntry *a, const XrefEntry *b)
+{
+	return a->kind == b->kind
+		&& a->target == b->target
+		&& (ASMREF_EXTERNAL != a->kind || 0 == strcmp(a->label, b->label));
+}
+
+
+static void XrefModule(RecordSink *sink, FILE *outFile, OS9ROF *rfile)
+{
+	XrefTable *table;
+
+	(void)outFile;
+
+	table = sink->context;
+	table->count = 0;
+	strcpy(table->name, rfile->name);
+}
+
+
+/*************************************************************************** 
+	Note the reference made by an instruction
+***************************************************************************/
+static void XrefInstruction(RecordSink *sink, FILE *outFile, const AsmRecord *record, const u_char *bytes)
+{
+	XrefTable *table;
+	XrefEntry *entry;
+
+	(void)outFile;
+	(void)bytes;
+
+	table = sink->context;
+	if(ASMREF_NONE == record->refKind || TRUE == table->failed)
+	{
+		return;
+	}
+
+	if(table->count == table->size)
+	{
+		XrefEntry *entries;
+		u_int32 size;
+
+		size = 0 != table->size ? table->size * 2 : INITIAL_ENTRIES;
+		entries = MemRealloc(MEM_OUTPUT, table->entries, size * sizeof(XrefEntry));
+		if(NULL == entries)
+		{
+			table->failed = TRUE;
+			return;
+		}
+		table->entries = entries;
+		table->size = size;
+	}
+
+	entry = &table->entries[table->count++];
+	entry->kind = record->refKind;
+	entry->target = record->refTarget;
+	entry->from = record->address;
+	strcpy(entry->label, record->refLabel);
+}
+
+
+static void XrefData(RecordSink *sink, FILE *outFile, int section, const u_char *bytes, u_int16 address, u_int16 length)
+{
+	(void)sink;
+	(void)outFile;
+	(void)section;
+	(void)bytes;
+	(void)address;
+	(void)length;
+}
+
+
+/*************************************************************************** 
+	Generate the table for the module
+***************************************************************************/
+static void XrefEnd(RecordSink *sink, FILE *outFile)
+{
+	XrefTable *table;
+	u_int32 index;
+	int column;
+
+	table = sink->context;
+
+	GenRaw(outFile, "*\n* Cross references for %s\n*\n", table->name);
+	if(TRUE == table->failed)
+	{
+		GenRaw(outFile, "* Out of memory, table is incomplete\n");
+	}
+	GenRaw(outFile, "%-24s%-12s%s\t%s\n", "* Label", "Kind", "Target", "Referenced from");
+
+	qsort(table->entries, table->count, sizeof(XrefEntry), CompareEntries);
+
+	column = 0;
+	for(index = 0; index < table->count; index++)
+	{
+		const XrefEntry *entry;
+
+		entry = &table->entries[index];
+		if(0 == index || FALSE == SameTarget(entry, &table->entries[index - 1]))
+		{
+			if(0 != index)
+			{
+				GenRaw(outFile, "\n");
+			}
+			GenRaw(outFile, "%-24s%-12s$%04X\t", entry->label, kindNames[entry->kind], entry->target);
+			column = 0;
+		}
+		else if(FROM_PER_LINE == column)
+		{
+			GenRaw(outFile, "\n%-24s%-12s     \t", "", "");
+			column = 0;
+		}
+
+		GenRaw(outFile, "%s$%04X", 0 != column ? " " : "", entry->from);
+		column++;
+	}
+
+	if(0 != table->count)
+	{
+		GenRaw(outFile, "\n");
+	}
+}
+
+
+/*************************************************************************** 
+	Set up a sink that builds a cross reference table
+***************************************************************************/
+void XrefSinkInit(RecordSink *sink, XrefTable *table)
+{
+	memset(table, 0, sizeof(XrefTable));
+
+	sink->module = XrefModule;
+	sink->instruction = XrefInstruction;
+	sink->data = XrefData;
+	sink->end = XrefEnd;
+	sink->context = table;
+	sink->output = NULL;
+	sink->next = NULL;
+}
+
+
+void XrefTableFree(XrefTable *table)
+{
+	MemFree(table->entries);
+	memset(table, 0, sizeof(XrefTable));
+}
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/
@@ -0,0 +1,65 @@
+/*****************************************************************************
+	xref.h	- Cross reference table of disassembled modules
+
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson.
+
+	This file is distributed under the MIT License. See notice at the end
+	of this file.
+
+*****************************************************************************/
+#ifndef XREF_H
+#define XREF_H
+
+#include "rof.h"
+#include "genasm.h"
+
+typedef struct
+{
+	ASMREF		kind;					/* Kind of reference */
+	u_int16		target;					/* Address referenced */
+	u_int16		from;					/* Address of the referencing instruction */
+	char		label[SYMLEN + 2];		/* Label of the target */
+} XrefEntry;
+
+typedef struct
+{
+	XrefEntry	*entries;		/* References found in the module */
+	u_int32		count;
+	u_int32		size;
+	char		name[256];		/* Name of the module */
+	BOOL		failed;			/* Ran out of memory */
+} XrefTable;
+
+void XrefSinkInit(RecordSink *sink, XrefTable *table);
+void XrefTableFree(XrefTable *table);
+
+#endif	/* XREF_H */
+
+
+
+/*****************************************************************************
+	
+	Copyright (C) 1996, 1997, 2014, 2018, by Chet Simpson
+	
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+	
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+	
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+	
+*****************************************************************************/